@@ -0,0 +1,153 @@
+#######################################################################################################################
+##! \file
+##! \author Pélégrin Marius
+##! \copyright The MIT License (MIT)
+##! \date 2022-2023
+#######################################################################################################################
+
+# Compiles GLSL files to SPIR-V at build time with glslang, and embeds the binaries in a target.
+#
+#   splaylibrary_add_shaders(
+#       <target>
+#       [NAMESPACE <namespace>]                 # Namespace of the generated symbols, "shaders" by default
+#       [BASE_DIRECTORY <directory>]            # Directory the symbol names are relative to, the current source dir by default
+#       [INCLUDE_DIRECTORIES <directory>...]    # Directories searched by "#include" (GL_GOOGLE_include_directive)
+#       SHADERS <file>...                       # GLSL files, the stage is given by the extension (.vert, .frag.glsl, ...)
+#   )
+#
+# Each shader "<dir>/<name>.<stage>" is exposed as "const spl::EmbeddedSpirV <namespace>::<dir>_<name>_<stage>",
+# declared in the generated header "SplayLibraryShaders/<target>.hpp", and can be loaded with
+# "spl::ShaderModule::createFromSpirV". The shaders must follow the OpenGL SPIR-V rules (explicit uniform locations,
+# no default block uniforms without location...).
+#
+# This file is also run as a script (with -P) to generate the source file embedding each binary.
+
+if(CMAKE_SCRIPT_MODE_FILE)
+
+    file(READ ${SPIRV_FILE} SPIRV_CONTENT HEX)
+    string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1, " SPIRV_BYTES "${SPIRV_CONTENT}")
+    string(REGEX REPLACE "((0x[0-9a-f][0-9a-f], ){32})" "\\1\n\t\t\t" SPIRV_BYTES "${SPIRV_BYTES}")
+
+    file(
+        WRITE ${OUTPUT_FILE}
+        "// Generated by splaylibrary_add_shaders from \"${SHADER_NAME}\", do not edit.\n"
+        "\n"
+        "#include <SplayLibrary/SplayLibrary.hpp>\n"
+        "\n"
+        "namespace ${SHADER_NAMESPACE}\n"
+        "{\n"
+        "\tnamespace\n"
+        "\t{\n"
+        "\t\talignas(uint32_t) const uint8_t ${SHADER_SYMBOL}_data[] = {\n"
+        "\t\t\t${SPIRV_BYTES}\n"
+        "\t\t};\n"
+        "\t}\n"
+        "\n"
+        "\textern const spl::EmbeddedSpirV ${SHADER_SYMBOL} = { \"${SHADER_NAME}\", spl::ShaderStage::${SHADER_STAGE}, ${SHADER_SYMBOL}_data, sizeof(${SHADER_SYMBOL}_data) };\n"
+        "}\n"
+    )
+
+    return()
+
+endif()
+
+set(_SPLAYLIBRARY_SHADERS_SCRIPT ${CMAKE_CURRENT_LIST_FILE} CACHE INTERNAL "")
+
+find_program(SPLAYLIBRARY_GLSLANG_VALIDATOR NAMES glslangValidator glslang HINTS $ENV{VULKAN_SDK}/bin $ENV{VULKAN_SDK}/Bin)
+
+function(splaylibrary_add_shaders TARGET)
+
+    cmake_parse_arguments(PARSE_ARGV 1 ARG "" "NAMESPACE;BASE_DIRECTORY" "INCLUDE_DIRECTORIES;SHADERS")
+
+    if(NOT SPLAYLIBRARY_GLSLANG_VALIDATOR)
+        message(FATAL_ERROR "splaylibrary_add_shaders: glslangValidator not found, set SPLAYLIBRARY_GLSLANG_VALIDATOR.")
+    endif()
+
+    if(NOT ARG_NAMESPACE)
+        set(ARG_NAMESPACE shaders)
+    endif()
+
+    if(NOT ARG_BASE_DIRECTORY)
+        set(ARG_BASE_DIRECTORY ${CMAKE_CURRENT_SOURCE_DIR})
+    endif()
+
+    set(OUTPUT_DIRECTORY ${CMAKE_CURRENT_BINARY_DIR}/splaylibrary_shaders/${TARGET})
+
+    set(INCLUDE_FLAGS "")
+    foreach(INCLUDE_DIRECTORY ${ARG_INCLUDE_DIRECTORIES})
+        get_filename_component(INCLUDE_DIRECTORY ${INCLUDE_DIRECTORY} ABSOLUTE)
+        list(APPEND INCLUDE_FLAGS -I${INCLUDE_DIRECTORY})
+    endforeach()
+
+    set(GENERATED_SOURCES "")
+    set(DECLARATIONS "")
+
+    foreach(SHADER_FILE ${ARG_SHADERS})
+
+        get_filename_component(SHADER_FILE ${SHADER_FILE} ABSOLUTE)
+        file(RELATIVE_PATH SHADER_NAME ${ARG_BASE_DIRECTORY} ${SHADER_FILE})
+
+        # Deduce the stage from the extension
+
+        if(NOT SHADER_NAME MATCHES "\\.(vert|tesc|tese|geom|frag|comp)(\\.glsl)?$")
+            message(FATAL_ERROR "splaylibrary_add_shaders: cannot deduce the stage of \"${SHADER_FILE}\".")
+        endif()
+
+        set(GLSLANG_STAGE ${CMAKE_MATCH_1})
+        set(STAGE_vert Vertex)
+        set(STAGE_tesc TessControl)
+        set(STAGE_tese TessEvaluation)
+        set(STAGE_geom Geometry)
+        set(STAGE_frag Fragment)
+        set(STAGE_comp Compute)
+        set(SHADER_STAGE ${STAGE_${GLSLANG_STAGE}})
+
+        string(MAKE_C_IDENTIFIER ${SHADER_NAME} SHADER_SYMBOL)
+
+        set(SPIRV_FILE ${OUTPUT_DIRECTORY}/${SHADER_NAME}.spv)
+        set(OUTPUT_FILE ${OUTPUT_DIRECTORY}/${SHADER_NAME}.spv.cpp)
+        get_filename_component(SPIRV_DIRECTORY ${SPIRV_FILE} DIRECTORY)
+
+        # Compile to SPIR-V, then embed the binary in a source file
+
+        add_custom_command(
+            OUTPUT ${SPIRV_FILE}
+            COMMAND ${CMAKE_COMMAND} -E make_directory ${SPIRV_DIRECTORY}
+            COMMAND ${SPLAYLIBRARY_GLSLANG_VALIDATOR} -G -S ${GLSLANG_STAGE} ${INCLUDE_FLAGS} --depfile ${SPIRV_FILE}.d -o ${SPIRV_FILE} ${SHADER_FILE}
+            DEPENDS ${SHADER_FILE}
+            DEPFILE ${SPIRV_FILE}.d
+            COMMENT "Compiling ${SHADER_NAME} to SPIR-V"
+            VERBATIM
+        )
+
+        add_custom_command(
+            OUTPUT ${OUTPUT_FILE}
+            COMMAND ${CMAKE_COMMAND}
+                -DSPIRV_FILE=${SPIRV_FILE}
+                -DOUTPUT_FILE=${OUTPUT_FILE}
+                -DSHADER_NAME=${SHADER_NAME}
+                -DSHADER_NAMESPACE=${ARG_NAMESPACE}
+                -DSHADER_SYMBOL=${SHADER_SYMBOL}
+                -DSHADER_STAGE=${SHADER_STAGE}
+                -P ${_SPLAYLIBRARY_SHADERS_SCRIPT}
+            DEPENDS ${SPIRV_FILE} ${_SPLAYLIBRARY_SHADERS_SCRIPT}
+            COMMENT "Embedding ${SHADER_NAME}"
+            VERBATIM
+        )
+
+        list(APPEND GENERATED_SOURCES ${OUTPUT_FILE})
+        string(APPEND DECLARATIONS "\textern const spl::EmbeddedSpirV ${SHADER_SYMBOL};\n")
+
+    endforeach()
+
+    # Header declaring the embedded shaders
+
+    file(
+        GENERATE OUTPUT ${OUTPUT_DIRECTORY}/include/SplayLibraryShaders/${TARGET}.hpp
+        CONTENT "// Generated by splaylibrary_add_shaders, do not edit.\n\n#pragma once\n\n#include <SplayLibrary/SplayLibrary.hpp>\n\nnamespace ${ARG_NAMESPACE}\n{\n${DECLARATIONS}}\n"
+    )
+
+    target_sources(${TARGET} PRIVATE ${GENERATED_SOURCES})
+    target_include_directories(${TARGET} PRIVATE ${OUTPUT_DIRECTORY}/include)
+
+endfunction()
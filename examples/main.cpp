@@ -6,8 +6,23 @@
 
 // TODO: Finish scp::Quat
 
-int main()
+int main(int argc, char** argv)
 {
+	// The example to run can be selected with its name as first argument
+
+	if (argc > 1)
+	{
+		const std::string_view example = argv[1];
+		if (example == "advancedLighting")
+		{
+			return advancedLightingMain();
+		}
+		else if (example == "uniformBenchmark")
+		{
+			return uniformBenchmarkMain();
+		}
+	}
+
 	// std::thread basicPhongThread(&basicPhongMain);
 	// std::thread advancedLightingThread(&advancedLightingMain);
 	// 
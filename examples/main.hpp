@@ -3,4 +3,5 @@
 #include <SplayLibrary/SplayLibrary.hpp>
 
 int basicPhongMain();
-int advancedLightingMain();
\ No newline at end of file
+int advancedLightingMain();
+int uniformBenchmarkMain();
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include "../main.hpp"
+
+#include <chrono>
+
+int uniformBenchmarkMain()
+{
+	spl::Window window(1000, 600, "SPL Example", true);
+	spl::Context* context = window.getContext();
+	spl::Context::setCurrentContext(context);
+	context->setClearColor(0.2f, 0.3f, 0.3f, 1.f);
+
+	spl::ShaderProgram shader("examples/basicPhong/resources/shaders/main.vert", "examples/basicPhong/resources/shaders/main.frag");
+	spl::ShaderProgram::bind(&shader);
+
+	// Compare 100k "setUniform" per frame, using the name of the uniform, its hash computed at compile time or a handle
+	// resolved once
+
+	using spl::operator""_u;
+
+	static constexpr uint32_t setCount = 100000;
+
+	const spl::UniformHandle modelHandle = shader.getUniformHandle("model");
+	const spl::UniformHandle lightDirHandle = shader.getUniformHandle("lightDir");
+
+	const scp::f32mat4x4 model = {
+		1.f, 0.f, 0.f, 0.f,
+		0.f, 1.f, 0.f, 0.f,
+		0.f, 0.f, 1.f, 0.f,
+		0.f, 0.f, 0.f, 1.f
+	};
+	const scp::f32vec3 lightDir = -scp::normalize(scp::f32vec3{ 1.0, 1.0, 1.0 });
+
+	uint32_t frame = 0;
+	while (!window.shouldClose())
+	{
+		spl::Event* rawEvent = nullptr;
+		while (window.pollEvent(rawEvent));
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (uint32_t i = 0; i < setCount; i += 2)
+		{
+			shader.setUniform("model", model);
+			shader.setUniform("lightDir", lightDir);
+		}
+		const double nameTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		start = std::chrono::steady_clock::now();
+		for (uint32_t i = 0; i < setCount; i += 2)
+		{
+			shader.setUniform("model"_u, model);
+			shader.setUniform("lightDir"_u, lightDir);
+		}
+		const double hashTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		start = std::chrono::steady_clock::now();
+		for (uint32_t i = 0; i < setCount; i += 2)
+		{
+			shader.setUniform(modelHandle, model);
+			shader.setUniform(lightDirHandle, lightDir);
+		}
+		const double handleTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		if (frame++ % 60 == 0)
+		{
+			std::cout << "By name: " << nameTime << " ms | By hash: " << hashTime << " ms | By handle: " << handleTime << " ms" << std::endl;
+		}
+
+		window.display();
+		spl::Framebuffer::clear();
+	}
+
+	return 0;
+}
@@ -0,0 +1,73 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2021-2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <SplayLibrary/Core/CoreTypes.hpp>
+
+namespace spl
+{
+	/*
+
+	Table of textures stored in a shader storage buffer, so that a whole scene can index its textures (e.g. from its
+	materials) without binding any of them. Each element is a 64-bit value, read as a uvec2 in GLSL:
+
+		- With ARB_bindless_texture, it is the resident handle of the texture, converted with "sampler2D(element)".
+		- Without it, "bind" also binds the textures to consecutive texture units from "firstTextureUnit", and the
+		element holds the texture unit in "x" to index an array of samplers. The GLSL rules then apply: the index must
+		be dynamically uniform, and the table is limited by the number of texture units.
+
+	Shaders can select the path with "#ifdef GL_ARB_bindless_texture". Textures and samplers must outlive the table. On
+	the bindless path, their sampling parameters (filtering, wrapping...) cannot be changed once they are in the table.
+
+	*/
+	class SPL_API BindlessTextureTable
+	{
+		public:
+
+			BindlessTextureTable();
+			BindlessTextureTable(const BindlessTextureTable& table) = delete;
+			BindlessTextureTable(BindlessTextureTable&& table) = delete;
+
+			BindlessTextureTable& operator=(const BindlessTextureTable& table) = delete;
+			BindlessTextureTable& operator=(BindlessTextureTable&& table) = delete;
+
+
+			uint32_t add(const Texture& texture, const Sampler* sampler = nullptr);
+			void set(uint32_t index, const Texture& texture, const Sampler* sampler = nullptr);
+			void remove(uint32_t index);
+			void clear();
+
+			void bind(uint32_t bindingIndex, uint32_t firstTextureUnit = 0);
+
+
+			const Buffer& getBuffer() const;
+			uint32_t getSize() const;
+			bool isBindless() const;
+
+
+			~BindlessTextureTable();
+
+		private:
+
+			struct Element
+			{
+				const Texture* texture = nullptr;
+				const Sampler* sampler = nullptr;
+				uint64_t handle = 0;
+			};
+
+			void _upload(uint32_t firstTextureUnit);
+
+			std::vector<Element> _elements;
+			std::vector<uint32_t> _freeIndices;
+
+			Buffer _buffer;
+			bool _isDirty;
+			uint32_t _firstTextureUnit;
+	};
+}
@@ -121,6 +121,8 @@ namespace spl
 
 			void invalidate(uintptr_t size = -1, uintptr_t offset = 0);
 
+			void setLabel(const std::string& label);
+
 			void destroy();
 
 
@@ -133,6 +135,7 @@ namespace spl
 			BufferMapAccessFlags::Flags getMapAccessFlags() const;
 			uintptr_t getMapSize() const;
 			uintptr_t getMapOffset() const;
+			const std::string& getLabel() const;
 
 			bool isValid() const;
 			bool hasImmutableStorage() const;
@@ -158,5 +161,12 @@ namespace spl
 			BufferMapAccessFlags::Flags _mapAccess;
 			uintptr_t _mapSize;
 			uintptr_t _mapOffset;
+
+			std::string _label;
+
+			mutable std::vector<std::tuple<Context*, BufferTarget, uint32_t>> _contextBindings;	// Slots of the contexts the buffer is bound to
+			mutable uint64_t _shaderWriteEpoch;
+
+		friend class Context;
 	};
 }
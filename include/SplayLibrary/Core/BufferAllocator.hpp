@@ -0,0 +1,87 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2021-2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <SplayLibrary/Core/CoreTypes.hpp>
+
+namespace spl
+{
+	/*
+
+	Sub-allocates ranges of a single buffer. Allocations are referenced by handles and their offsets must be retrieved
+	with getOffset each time they are used (vertex array binding, draw first/baseVertex...) because defragment may move
+	them at any time. Moves are done on the GPU so no synchronisation with the CPU is needed.
+
+	After each call to defragment, getMovedHandles lists the allocations it moved, so that the vertex array bindings
+	and the baseVertex values computed from their former offsets can be updated.
+
+	*/
+	class SPL_API BufferAllocator
+	{
+		public:
+
+			BufferAllocator();
+			BufferAllocator(uintptr_t size, BufferStorageFlags::Flags flags, uintptr_t alignment = 1);
+			BufferAllocator(const BufferAllocator& allocator) = delete;
+			BufferAllocator(BufferAllocator&& allocator) = delete;
+
+			BufferAllocator& operator=(const BufferAllocator& allocator) = delete;
+			BufferAllocator& operator=(BufferAllocator&& allocator) = delete;
+
+
+			void createNew(uintptr_t size, BufferStorageFlags::Flags flags, uintptr_t alignment = 1);
+
+			uint32_t allocate(uintptr_t size, const void* data = nullptr);
+			void update(uint32_t handle, const void* data, uintptr_t size = -1, uintptr_t offset = 0);
+			void free(uint32_t handle);
+
+			uintptr_t defragment(uintptr_t maxBytesMoved);
+
+			void destroy();
+
+
+			const Buffer& getBuffer() const;
+			uintptr_t getAlignment() const;
+			uintptr_t getOffset(uint32_t handle) const;
+			uintptr_t getSize(uint32_t handle) const;
+			uintptr_t getAllocatedSize() const;
+			uintptr_t getLargestFreeBlockSize() const;
+			uint32_t getFreeBlockCount() const;
+			const std::vector<uint32_t>& getMovedHandles() const;
+
+			bool isValid() const;
+			bool isAllocated(uint32_t handle) const;
+
+
+			~BufferAllocator();
+
+		private:
+
+			struct Allocation
+			{
+				uintptr_t offset = 0;
+				uintptr_t size = 0;
+				bool allocated = false;
+			};
+
+			uintptr_t _alignSize(uintptr_t size) const;
+			void _insertFreeBlock(uintptr_t offset, uintptr_t size);
+
+			Buffer _buffer;
+			Buffer _scratch;
+			uintptr_t _alignment;
+			uintptr_t _allocatedSize;
+
+			std::vector<Allocation> _allocations;
+			std::vector<uint32_t> _freeHandles;
+			std::map<uintptr_t, uint32_t> _allocationsByOffset;
+			std::map<uintptr_t, uintptr_t> _freeBlocks;
+
+			std::vector<uint32_t> _movedHandles;	// Handles moved by the last call to defragment
+	};
+}
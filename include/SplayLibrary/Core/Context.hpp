@@ -381,6 +381,48 @@ namespace spl
 		// TODO: OneMinusSrc1Alpha
 	};
 
+	namespace MemoryBarrierFlags
+	{
+		enum Flags
+		{
+			None				= 0,
+			VertexAttribArray	= 1 << 0,
+			ElementArray		= 1 << 1,
+			Uniform				= 1 << 2,
+			TextureFetch		= 1 << 3,
+			ShaderImageAccess	= 1 << 4,
+			Command				= 1 << 5,
+			PixelBuffer			= 1 << 6,
+			TextureUpdate		= 1 << 7,
+			BufferUpdate		= 1 << 8,
+			Framebuffer			= 1 << 9,
+			TransformFeedback	= 1 << 10,
+			AtomicCounter		= 1 << 11,
+			ShaderStorage		= 1 << 12,
+			ClientMappedBuffer	= 1 << 13,
+			QueryBuffer			= 1 << 14,
+			All					= (1 << 15) - 1
+		};
+	}
+
+	struct MemoryUsage
+	{
+		uint64_t bytes = 0;
+		uint64_t highWaterMark = 0;
+	};
+
+	struct MemoryStatistics
+	{
+		MemoryUsage total = {};
+		MemoryUsage buffers = {};
+		MemoryUsage textures = {};
+		MemoryUsage renderbuffers = {};
+
+		std::array<MemoryUsage, 10> buffersByUsage = {};								// Indexed by BufferUsage (Undefined for immutable storage)
+		std::unordered_map<uint32_t, MemoryUsage> buffersByStorageFlags = {};			// Indexed by BufferStorageFlags::Flags (immutable storage only)
+		std::unordered_map<std::string, MemoryUsage> labels = {};
+	};
+
 	struct IndexedBufferBinding
 	{
 		const Buffer* buffer = nullptr;
@@ -412,8 +454,10 @@ namespace spl
 		std::array<std::vector<IndexedBufferBinding>, 4> indexedBufferBindings = {};
 		std::vector<const Texture*> textureBindings = {};
 		std::vector<const Sampler*> samplerBindings = {};
+		std::vector<ImageUnitBinding> imageBindings = {};
 		std::array<const Framebuffer*, 2> framebufferBindings = { nullptr, nullptr };
 		const ShaderProgram* shaderBinding = nullptr;
+		const ShaderPipeline* shaderPipelineBinding = nullptr;
 
 		static uint8_t bufferTargetToIndex(BufferTarget target);
 		static uint8_t indexedBufferTargetToIndex(BufferTarget target);
@@ -485,11 +529,27 @@ namespace spl
 			const IndexedBufferBinding& getIndexedBufferBinding(BufferTarget target, uint32_t index) const;
 			const Texture* getTextureBinding(uint32_t textureUnit) const;
 			const Sampler* getSamplerBinding(uint32_t textureUnit) const;
+			const ImageUnitBinding& getImageBinding(uint32_t imageUnit) const;
 			const Framebuffer* getFramebufferBinding(FramebufferTarget target) const;
 			const ShaderProgram* getShaderBinding() const;
+			const ShaderPipeline* getShaderPipelineBinding() const;
 
 			const ContextState& getState() const;
 
+			// GPU memory accounting (process-wide, shared by all the contexts)
+
+			static MemoryStatistics getMemoryStatistics();
+			static void resetMemoryHighWaterMarks();
+
+			// Shader compilation
+
+			bool getIsParallelShaderCompileSupported() const;
+			void setMaxShaderCompilerThreads(uint32_t count);
+
+			// Memory barriers (those needed after shader writes to buffers and images are issued automatically)
+
+			void memoryBarrier(MemoryBarrierFlags::Flags flags);
+
 			// Multi-context and window related functions
 
 			Window* getWindow();
@@ -511,11 +571,33 @@ namespace spl
 			void _onFirstActivation();
 			void _loadImplementationDependentValues();
 
+			void _setBufferBinding(BufferTarget target, const Buffer* buffer);
+			void _setIndexedBufferBinding(BufferTarget target, uint32_t index, const IndexedBufferBinding& binding);
+			void _setTextureBinding(uint32_t textureUnit, const Texture* texture);
+			void _setSamplerBinding(uint32_t textureUnit, const Sampler* sampler);
+			void _setImageBinding(uint32_t imageUnit, const ImageUnitBinding& binding);
+			void _dropBindings();
+
+			static void _addBufferMemory(BufferUsage usage, BufferStorageFlags::Flags flags, const std::string& label, int64_t bytes);
+			static void _addTextureMemory(const std::string& label, int64_t bytes);
+			static void _addRenderbufferMemory(const std::string& label, int64_t bytes);
+			static void _moveMemoryLabel(const std::string& oldLabel, const std::string& newLabel, uint64_t bytes);
+
 			void _unbindBuffer(const Buffer* buffer);
 			void _unbindTexture(const Texture* texture);
 			void _unbindSampler(const Sampler* sampler);
 			void _unbindFramebuffer(const Framebuffer* framebuffer);
 			void _unbindShaderProgram(const ShaderProgram* program);
+			void _unbindShaderPipeline(const ShaderPipeline* pipeline);
+
+			void _prepareShaderInvocation(const VertexArray* vertexArray, bool isIndexed, const Buffer* indirectBuffer, const Buffer* parameterBuffer = nullptr);
+			void _prepareBufferUpdate(const Buffer* buffer);
+			void _prepareTextureUpdate(const Texture* texture, const Buffer* pixelBuffer);
+			void _recordShaderWrites();
+			bool _isMemoryBarrierPending(MemoryBarrierFlags::Flags flag) const;
+			void _requireMemoryBarrier(const Buffer* buffer, MemoryBarrierFlags::Flags flag);
+			void _requireMemoryBarrier(const Texture* texture, MemoryBarrierFlags::Flags flag);
+			void _issueRequiredMemoryBarriers();
 
 			ImplementationDependentValues _implementationDependentValues;
 
@@ -525,6 +607,11 @@ namespace spl
 
 			ContextState _state;
 
+			uint64_t _shaderWriteEpoch;
+			std::array<uint64_t, 15> _memoryBarrierEpochs;
+			MemoryBarrierFlags::Flags _requiredMemoryBarriers;
+			uint32_t _writableBindingCount;
+
 			Window* _window;
 			bool _hasBeenActivated;
 
@@ -532,13 +619,19 @@ namespace spl
 			static std::unordered_set<Context*> _contexts;
 			static std::unordered_map<std::thread::id, Context*> _currentContexts;
 
+			static std::mutex _memoryMutex;
+			static MemoryStatistics _memoryStatistics;	// Resources may be created and destroyed in different contexts
+
 		friend class Window;
 		friend void stackDebugMessage(DebugMessage* message, Context* context);
 
 		friend class Buffer;
 		friend class Sampler;
 		friend class Texture;
+		friend class Renderbuffer;
 		friend class Framebuffer;
+		friend class VertexArray;
 		friend class ShaderProgram;
+		friend class ShaderPipeline;
 	};
 }
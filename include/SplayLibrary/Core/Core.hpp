@@ -20,4 +20,6 @@
 #include <SplayLibrary/Core/templates/Texture.hpp>
 
 #include <SplayLibrary/Core/templates/ShaderProgram.hpp>
+#include <SplayLibrary/Core/templates/ParameterBlock.hpp>
+#include <SplayLibrary/Core/templates/ShaderSpecializer.hpp>
 
@@ -16,17 +16,31 @@
 
 
 #include <SplayLibrary/Core/Buffer.hpp>
+#include <SplayLibrary/Core/BufferAllocator.hpp>
 
 #include <SplayLibrary/Core/Sampler.hpp>
 #include <SplayLibrary/Core/FramebufferAttachable.hpp>
 #include <SplayLibrary/Core/Texture.hpp>
 #include <SplayLibrary/Core/Renderbuffer.hpp>
 #include <SplayLibrary/Core/Texture/Texture2D.hpp>
+#include <SplayLibrary/Core/TextureResidency.hpp>
+#include <SplayLibrary/Core/BindlessTextureTable.hpp>
 
 #include <SplayLibrary/Core/ShaderModule.hpp>
 #include <SplayLibrary/Core/ShaderProgram.hpp>
+#include <SplayLibrary/Core/ShaderBinary.hpp>
+#include <SplayLibrary/Core/ShaderBinaryCache.hpp>
+#include <SplayLibrary/Core/ShaderPipeline.hpp>
+#include <SplayLibrary/Core/ParameterBlock.hpp>
+#include <SplayLibrary/Core/ProgramCache.hpp>
+#include <SplayLibrary/Core/ShaderPreprocessor.hpp>
+#include <SplayLibrary/Core/ShaderReloader.hpp>
+#include <SplayLibrary/Core/ShaderSpecializer.hpp>
+#include <SplayLibrary/Core/SpirVModuleCache.hpp>
 
 #include <SplayLibrary/Core/VertexArray.hpp>
+#include <SplayLibrary/Core/DrawCommandBuffer.hpp>
+#include <SplayLibrary/Core/FrustumCuller.hpp>
 
 #include <SplayLibrary/Core/Framebuffer.hpp>
 #include <SplayLibrary/Core/DefaultFramebuffer.hpp>
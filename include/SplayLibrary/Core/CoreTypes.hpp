@@ -9,20 +9,24 @@
 
 #include <algorithm>
 #include <atomic>
+#include <bit>
 #include <bitset>
 #include <cassert>
 #include <charconv>
+#include <chrono>
 #include <cmath>
 #include <cstdarg>
 #include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <queue>
 #include <string>
 #include <thread>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -81,6 +85,8 @@ namespace spl
 	namespace BufferMapAccessFlags { enum Flags; }
 	class Buffer;
 
+	class BufferAllocator;
+
 
 	enum class CompareFunc;
 	enum class TextureCompareMode;
@@ -96,14 +102,19 @@ namespace spl
 	enum class TextureInternalFormat : uint64_t;
 	struct TextureCreationParams;
 	struct TextureUpdateParams;
+	enum class ImageAccess;
+	struct ImageUnitBinding;
 	class Texture;
 
 	class Renderbuffer;
 
 	class Texture2D;
+	class TextureResidency;
+	class BindlessTextureTable;
 
 
 	namespace ShaderStage { enum Stage; }
+	struct EmbeddedSpirV;
 	class ShaderModule;
 
 	namespace ShaderProgramFlags { enum Flags; }
@@ -111,12 +122,31 @@ namespace spl
 	enum class GlslType;
 	struct ShaderProgramInterfaceInfos;
 	struct ShaderProgramResourceInfos;
+	struct Name;
+	struct ShaderProgramResourceLocation;
+	struct UniformHandle;
 	class ShaderProgram;
 
+	class ShaderBinary;
+	class ShaderBinaryCache;
+
+	class ShaderPipeline;
+	class ParameterBlock;
+	class ProgramCache;
+	class ShaderPreprocessor;
+	class ShaderReloader;
+	class ShaderSpecializer;
+	class SpirVModuleCache;
+
 
 	enum class PrimitiveType;
 	enum class IndexType;
+	struct DrawArraysCommand;
+	struct DrawElementsCommand;
 	class VertexArray;
+	class DrawCommandBuffer;
+	struct CullingInstance;
+	class FrustumCuller;
 
 
 	enum class FramebufferTarget;
@@ -151,6 +181,9 @@ namespace spl
 	enum class FaceCullingMode;
 	enum class BlendEquation;
 	enum class BlendFunc;
+	namespace MemoryBarrierFlags { enum Flags; }
+	struct MemoryUsage;
+	struct MemoryStatistics;
 	struct IndexedBufferBinding;
 	struct ContextState;
 	class Context;
@@ -0,0 +1,82 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2021-2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <SplayLibrary/Core/CoreTypes.hpp>
+
+namespace spl
+{
+	/*
+
+	Builder of draw commands in a persistently mapped buffer, to submit many draws with a single multi-draw indirect
+	call. The buffer is split in "frameCount" regions used in turn: "begin" moves to the next region, waiting for the
+	GPU to be done with the draws that read it "frameCount" frames ago, "push" writes commands into it and "draw"
+	submits all the commands pushed since "begin".
+
+	The commands of a region must all be DrawArraysCommand or all be DrawElementsCommand. They are written with the
+	stride of DrawElementsCommand, so that both fit in the same buffer.
+
+	*/
+	class SPL_API DrawCommandBuffer
+	{
+		public:
+
+			DrawCommandBuffer();
+			DrawCommandBuffer(uint32_t capacity, uint32_t frameCount = 3);
+			DrawCommandBuffer(const DrawCommandBuffer& commandBuffer) = delete;
+			DrawCommandBuffer(DrawCommandBuffer&& commandBuffer) = delete;
+
+			DrawCommandBuffer& operator=(const DrawCommandBuffer& commandBuffer) = delete;
+			DrawCommandBuffer& operator=(DrawCommandBuffer&& commandBuffer) = delete;
+
+
+			void createNew(uint32_t capacity, uint32_t frameCount = 3);
+			void destroy();
+
+			void begin();
+			uint32_t push(const DrawArraysCommand& command);
+			uint32_t push(const DrawElementsCommand& command);
+			void draw(const VertexArray& vertexArray, PrimitiveType primitiveType);
+			void draw(const VertexArray& vertexArray, PrimitiveType primitiveType, IndexType indexType);
+
+
+			const Buffer& getBuffer() const;
+			uintptr_t getOffset() const;
+			uint32_t getStride() const;
+			uint32_t getCommandCount() const;
+			uint32_t getCapacity() const;
+			bool isValid() const;
+
+
+			~DrawCommandBuffer();
+
+		private:
+
+			enum class CommandType
+			{
+				Undefined,
+				Arrays,
+				Elements
+			};
+
+			void* _reserve(CommandType type);
+			void _fenceRegion();
+
+			static constexpr uint32_t _stride = sizeof(DrawElementsCommand);
+
+			Buffer _buffer;
+			uint32_t _capacity;
+			uint32_t _frameCount;
+
+			uint32_t _currentRegion;
+			uint32_t _commandCount;
+			CommandType _commandType;
+
+			std::vector<void*> _fences;	// GLsync of the last draw reading each region
+	};
+}
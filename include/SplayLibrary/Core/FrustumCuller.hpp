@@ -0,0 +1,84 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2021-2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <SplayLibrary/Core/CoreTypes.hpp>
+
+namespace spl
+{
+	// Layout of an instance in the instance buffer of a FrustumCuller (std430)
+
+	struct CullingInstance
+	{
+		scp::f32vec4 sphere;	// World space bounding sphere: center in xyz, radius in w
+		uint32_t meshIndex = 0;
+		uint32_t padding[3] = {};
+	};
+
+	/*
+
+	Frustum culling on the GPU. Each instance has a bounding sphere and the index of its mesh, a DrawElementsCommand
+	whose "count", "firstIndex" and "baseVertex" describe the mesh in the element buffer. "cull" dispatches a compute
+	shader that tests the instances against the frustum, and appends a command for each visible instance with an atomic
+	counter. "draw" then submits them with a single glMultiDrawElementsIndirectCount, so that the CPU cost does not
+	depend on the number of instances.
+
+	The commands have an "instanceCount" of 1 and a "baseInstance" equal to the index of the instance, retrieved with
+	"gl_BaseInstance" or through instanced attributes. "cull" binds its own program and uses the shader storage bindings
+	0 to 3.
+
+	*/
+	class SPL_API FrustumCuller
+	{
+		public:
+
+			FrustumCuller();
+			FrustumCuller(uint32_t instanceCapacity, uint32_t meshCapacity);
+			FrustumCuller(const FrustumCuller& culler) = delete;
+			FrustumCuller(FrustumCuller&& culler) = delete;
+
+			FrustumCuller& operator=(const FrustumCuller& culler) = delete;
+			FrustumCuller& operator=(FrustumCuller&& culler) = delete;
+
+
+			bool createNew(uint32_t instanceCapacity, uint32_t meshCapacity);
+			void setMeshes(const DrawElementsCommand* meshes, uint32_t count, uint32_t firstMesh = 0);
+			void setInstances(const CullingInstance* instances, uint32_t count, uint32_t firstInstance = 0);
+			void setInstanceCount(uint32_t count);
+			void destroy();
+
+			void cull(const scp::f32mat4x4& viewProjection);
+			void draw(const VertexArray& vertexArray, PrimitiveType primitiveType, IndexType indexType) const;
+
+
+			const Buffer& getInstanceBuffer() const;
+			const Buffer& getMeshBuffer() const;
+			const Buffer& getCommandBuffer() const;
+			const Buffer& getCountBuffer() const;
+			uint32_t getInstanceCount() const;
+			uint32_t getInstanceCapacity() const;
+			bool isValid() const;
+
+
+			~FrustumCuller();
+
+		private:
+
+			static constexpr uint32_t _workGroupSize = 64;
+
+			std::shared_ptr<const ShaderProgram> _program;
+
+			Buffer _instanceBuffer;
+			Buffer _meshBuffer;
+			Buffer _commandBuffer;
+			Buffer _countBuffer;
+
+			uint32_t _instanceCount;
+			uint32_t _instanceCapacity;
+	};
+}
@@ -0,0 +1,104 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2021-2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <SplayLibrary/Core/CoreTypes.hpp>
+
+namespace spl
+{
+	/*
+
+	CPU copy of a std140 uniform block, to replace many setUniform calls by a single buffer update. The layout is taken
+	from the block "blockName" of the program given at creation, and the values are written in this copy with "set".
+	"upload" then copies the block in the next slice of a ring of slices of a uniform buffer, and binds this slice to
+	the binding point of the block. Writing each upload in a new slice avoids waiting for the draws still reading the
+	previous ones.
+
+	Programs opt in by declaring the same block, at the same binding point:
+
+		layout(std140, binding = 0) uniform Transforms
+		{
+			mat4 projection;
+			mat4 view;
+			mat4 model;
+		};
+
+	*/
+	class SPL_API ParameterBlock
+	{
+		public:
+
+			ParameterBlock();
+			ParameterBlock(const ShaderProgram& program, const std::string& blockName, uint32_t sliceCount = 256);
+			ParameterBlock(const ParameterBlock& block) = delete;
+			ParameterBlock(ParameterBlock&& block) = delete;
+
+			ParameterBlock& operator=(const ParameterBlock& block) = delete;
+			ParameterBlock& operator=(ParameterBlock&& block) = delete;
+
+
+			bool createFromProgram(const ShaderProgram& program, const std::string& blockName, uint32_t sliceCount = 256);
+
+			template<CGlslScalarType TScalar> void set(const std::string& name, const TScalar& scalar);
+			template<CGlslScalarType TScalar> void set(const std::string& name, const TScalar* scalars, uint32_t count);
+			template<CGlslVecType TVec> void set(const std::string& name, const TVec& vec);
+			template<CGlslVecType TVec> void set(const std::string& name, const TVec* vecs, uint32_t count);
+			template<CGlslMatType TMat> void set(const std::string& name, const TMat& mat);
+			template<CGlslMatType TMat> void set(const std::string& name, const TMat* mats, uint32_t count);
+			template<CGlslScalarType TScalar> void set(Name name, const TScalar& scalar);
+			template<CGlslScalarType TScalar> void set(Name name, const TScalar* scalars, uint32_t count);
+			template<CGlslVecType TVec> void set(Name name, const TVec& vec);
+			template<CGlslVecType TVec> void set(Name name, const TVec* vecs, uint32_t count);
+			template<CGlslMatType TMat> void set(Name name, const TMat& mat);
+			template<CGlslMatType TMat> void set(Name name, const TMat* mats, uint32_t count);
+
+			void upload();
+
+			void destroy();
+
+
+			bool isCompatible(const ShaderProgram& program) const;
+
+			const Buffer& getBuffer() const;
+			uint32_t getBindingIndex() const;
+			uintptr_t getSize() const;
+			uintptr_t getOffset() const;
+			uint32_t getUploadCount() const;
+			bool isValid() const;
+
+
+			~ParameterBlock();
+
+		private:
+
+			struct Member
+			{
+				GlslType type;
+				uint32_t offset;
+				uint32_t arraySize;
+				uint32_t arrayStride;
+				uint32_t matrixStride;
+				bool isRowMajor;
+			};
+
+			void _set(uint64_t nameHash, GlslType type, const void* values, uint32_t count);
+
+			uint64_t _blockNameHash;
+			uint32_t _bindingIndex;
+			std::unordered_map<uint64_t, Member> _members;
+
+			std::vector<uint8_t> _staging;
+			bool _isDirty;
+
+			Buffer _buffer;
+			uintptr_t _sliceStride;
+			uint32_t _sliceCount;
+			uint32_t _currentSlice;
+			uint32_t _uploadCount;
+	};
+}
@@ -0,0 +1,63 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2021-2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <SplayLibrary/Core/CoreTypes.hpp>
+
+namespace spl
+{
+	/*
+
+	Process-wide deduplication of programs. A program is identified by the current context, the source hashes of its
+	modules (in any order) and its flags: requesting an identical program returns the same shared instance instead of
+	linking a new one, so programs can also be compared by address (e.g. to sort draws).
+
+	The cache only keeps weak references, a program is destroyed with its last shared pointer. The entries of a context
+	are dropped when this context is destroyed.
+
+	*/
+	class SPL_API ProgramCache
+	{
+		public:
+
+			ProgramCache() = delete;
+			ProgramCache(const ProgramCache& cache) = delete;
+			ProgramCache(ProgramCache&& cache) = delete;
+
+			ProgramCache& operator=(const ProgramCache& cache) = delete;
+			ProgramCache& operator=(ProgramCache&& cache) = delete;
+
+
+			static std::shared_ptr<const ShaderProgram> getProgram(const ShaderModule* const* shaders, uint8_t count, ShaderProgramFlags::Flags flags = ShaderProgramFlags::None);
+
+			static uint32_t collect();
+
+
+			static uint32_t getProgramCount();
+
+
+			~ProgramCache() = default;
+
+		private:
+
+			struct Entry
+			{
+				const Context* context = nullptr;
+				ShaderProgramFlags::Flags flags = ShaderProgramFlags::None;
+				std::vector<uint64_t> moduleHashes = {};
+				std::weak_ptr<const ShaderProgram> program = {};
+			};
+
+			static void _dropContext(const Context* context);
+
+			static std::mutex _mutex;
+			static std::unordered_multimap<uint64_t, Entry> _programs;	// Entries by hash of their key, compared in full on lookup
+
+		friend class Context;
+	};
+}
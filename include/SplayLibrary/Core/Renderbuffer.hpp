@@ -23,11 +23,15 @@ namespace spl
 			Renderbuffer& operator=(const Renderbuffer& renderbuffer) = delete;
 			Renderbuffer& operator=(Renderbuffer&& renderbuffer) = delete;
 
+			void setLabel(const std::string& label);
+
 			bool isValid() const;
 			uint32_t getHandle() const;
 			const scp::u32vec2& getSize() const;
 			TextureInternalFormat getInternalFormat() const;
 			uint32_t getSampleCount() const;
+			const std::string& getLabel() const;
+			uint64_t getMemorySize() const;
 
 			virtual ~Renderbuffer() override;
 
@@ -37,5 +41,7 @@ namespace spl
 			scp::u32vec2 _size;
 			TextureInternalFormat _internalFormat;
 			uint32_t _samples;
+
+			std::string _label;
 	};
 }
@@ -73,6 +73,7 @@ namespace spl
 			void setWrappingR(TextureWrapping wrap);
 
 			bool isValid() const;
+			uint32_t getHandle() const;
 			const scp::f32vec4& getBorderColor() const;
 			TextureCompareMode getCompareMode() const;
 			CompareFunc getCompareFunc() const;
@@ -111,5 +112,11 @@ namespace spl
 			TextureWrapping _sWrap;
 			TextureWrapping _tWrap;
 			TextureWrapping _rWrap;
+
+			mutable std::vector<std::pair<Context*, uint32_t>> _contextBindings;	// Units of the contexts the sampler is bound to
+			mutable bool _hasBindlessHandle;	// Sampling parameters cannot be changed anymore
+
+		friend class Context;
+		friend class Texture;
 	};
 }
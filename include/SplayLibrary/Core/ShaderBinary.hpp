@@ -0,0 +1,54 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2021-2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <SplayLibrary/Core/CoreTypes.hpp>
+
+namespace spl
+{
+	class SPL_API ShaderBinary
+	{
+		public:
+
+			ShaderBinary();
+			ShaderBinary(const ShaderProgram& program);
+			ShaderBinary(const std::filesystem::path& path);
+			ShaderBinary(uint32_t format, const void* data, uint32_t size);
+			ShaderBinary(const ShaderBinary& binary) = default;
+			ShaderBinary(ShaderBinary&& binary) = default;
+
+			ShaderBinary& operator=(const ShaderBinary& binary) = default;
+			ShaderBinary& operator=(ShaderBinary&& binary) = default;
+
+
+			bool createFromProgram(const ShaderProgram& program);
+			bool createFromFile(const std::filesystem::path& path);
+			void createFromData(uint32_t format, const void* data, uint32_t size);
+
+			bool saveToFile(const std::filesystem::path& path) const;
+
+			void destroy();
+
+
+			uint32_t getFormat() const;
+			const void* getData() const;
+			uint32_t getSize() const;
+			bool isValid() const;
+
+
+			~ShaderBinary() = default;
+
+		private:
+
+			static constexpr uint32_t _fileMagic = 0x424C5053;	// "SPLB"
+			static constexpr uint32_t _fileVersion = 1;
+
+			uint32_t _format;
+			std::vector<uint8_t> _data;
+	};
+}
@@ -0,0 +1,58 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2021-2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <SplayLibrary/Core/CoreTypes.hpp>
+
+namespace spl
+{
+	/*
+
+	On-disk cache of program binaries. Programs are identified by the hash of their sources, of the defines injected
+	after the "#version" line, of the flags and of the driver (vendor, renderer and version strings). When the driver
+	rejects a cached binary, the program is compiled again from its sources and the cache entry is replaced.
+
+	The introspection data of each program is stored next to its binary, so loading a cached program does not query it.
+
+	*/
+	class SPL_API ShaderBinaryCache
+	{
+		public:
+
+			ShaderBinaryCache();
+			ShaderBinaryCache(const std::filesystem::path& directory);
+			ShaderBinaryCache(const ShaderBinaryCache& cache) = delete;
+			ShaderBinaryCache(ShaderBinaryCache&& cache) = delete;
+
+			ShaderBinaryCache& operator=(const ShaderBinaryCache& cache) = delete;
+			ShaderBinaryCache& operator=(ShaderBinaryCache&& cache) = delete;
+
+
+			void setDirectory(const std::filesystem::path& directory);
+
+			bool createProgram(ShaderProgram& program, const ShaderStage::Stage* stages, const std::filesystem::path* glslFiles, uint8_t count, const std::string& defines = "", ShaderProgramFlags::Flags flags = ShaderProgramFlags::None);
+			bool createProgram(ShaderProgram& program, const ShaderStage::Stage* stages, const char* const* sources, const uint32_t* sizes, uint8_t count, const std::string& defines = "", ShaderProgramFlags::Flags flags = ShaderProgramFlags::None);
+
+			void clear();
+
+
+			const std::filesystem::path& getDirectory() const;
+			uint32_t getHitCount() const;
+			uint32_t getMissCount() const;
+
+
+			~ShaderBinaryCache() = default;
+
+		private:
+
+			std::filesystem::path _directory;
+
+			uint32_t _hitCount;
+			uint32_t _missCount;
+	};
+}
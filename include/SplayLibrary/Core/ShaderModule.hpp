@@ -25,6 +25,15 @@ namespace spl
 		};
 	}
 
+	// SPIR-V binary embedded in an executable by the CMake function "splaylibrary_add_shaders"
+	struct EmbeddedSpirV
+	{
+		const char* name = nullptr;
+		ShaderStage::Stage stage = ShaderStage::None;
+		const void* data = nullptr;
+		uint32_t size = 0;
+	};
+
 	class SPL_API ShaderModule
 	{
 		public:
@@ -35,6 +44,7 @@ namespace spl
 			ShaderModule(ShaderStage::Stage stage, const char* const* sources, const uint32_t* sizes, uint32_t count);
 			ShaderModule(ShaderStage::Stage stage, const std::filesystem::path& spirvFile, const char* entryPoint, const uint32_t* constantIndices, const void* constantValues, uint32_t specializationConstantsCount);
 			ShaderModule(ShaderStage::Stage stage, const void* binary, uint32_t size, const char* entryPoint, const uint32_t* constantIndices, const void* constantValues, uint32_t specializationConstantsCount);
+			ShaderModule(const EmbeddedSpirV& spirv, const char* entryPoint, const uint32_t* constantIndices, const void* constantValues, uint32_t specializationConstantsCount);
 			ShaderModule(const ShaderModule& shader) = delete;
 			ShaderModule(ShaderModule&& shader) = delete;
 
@@ -47,12 +57,20 @@ namespace spl
 			bool createFromGlsl(ShaderStage::Stage stage, const char* const* sources, const uint32_t* sizes, uint32_t count);
 			bool createFromSpirV(ShaderStage::Stage stage, const std::filesystem::path& spirvFile, const char* entryPoint, const uint32_t* constantIndices, const void* constantValues, uint32_t specializationConstantsCount);
 			bool createFromSpirV(ShaderStage::Stage stage, const void* binary, uint32_t size, const char* entryPoint, const uint32_t* constantIndices, const void* constantValues, uint32_t specializationConstantsCount);
+			bool createFromSpirV(const EmbeddedSpirV& spirv, const char* entryPoint, const uint32_t* constantIndices, const void* constantValues, uint32_t specializationConstantsCount);
 			// TODO: Handle binary with a new class "ShaderBinary"
 
+			bool createFromGlslAsync(ShaderStage::Stage stage, const std::filesystem::path& glslFile);
+			void createFromGlslAsync(ShaderStage::Stage stage, const char* source, uint32_t size);
+			void createFromGlslAsync(ShaderStage::Stage stage, const char* const* sources, const uint32_t* sizes, uint32_t count);
+			bool isCompilationComplete() const;
+			bool waitCompilation();
+
 			void destroy();
 
 
 			uint32_t getHandle() const;
+			uint64_t getSourceHash() const;
 			bool isValid() const;
 
 
@@ -63,9 +81,17 @@ namespace spl
 		private:
 
 			static bool _loadFile(const std::filesystem::path& filename, char*& data, uint32_t& size);
+			static std::string _injectDefines(const char* source, uint32_t size, const std::string& defines);
+
+			static constexpr int32_t _compilePending = -1;
 
 			uint32_t _shader;
 			ShaderStage::Stage _stage;
 			int32_t _compileStatus;
+			uint64_t _sourceHash;	// Hash of the stage and the sources (or binary and specialization) the module was created from
+
+		friend class ShaderBinaryCache;
+		friend class ShaderPreprocessor;
+		friend class ShaderSpecializer;
 	};
 }
@@ -0,0 +1,64 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2021-2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <SplayLibrary/Core/CoreTypes.hpp>
+
+namespace spl
+{
+	/*
+
+	Combination of separable programs, one per stage. Changing the program of a stage does not require any link, and is
+	skipped entirely when this stage already uses that program. The pipeline does not own its programs: they must stay
+	valid as long as they are used by the pipeline. All the stages from Compute to Fragment can be set, the stage of index
+	i being the bit i of ShaderStage::Stage. The subroutines selected on the programs are applied each time the pipeline
+	is bound.
+
+	*/
+	class SPL_API ShaderPipeline
+	{
+		public:
+
+			ShaderPipeline();
+			ShaderPipeline(const ShaderPipeline& pipeline) = delete;
+			ShaderPipeline(ShaderPipeline&& pipeline) = delete;
+
+			ShaderPipeline& operator=(const ShaderPipeline& pipeline) = delete;
+			ShaderPipeline& operator=(ShaderPipeline&& pipeline) = delete;
+
+
+			void createNew();
+			void setStages(ShaderStage::Stage stages, const ShaderProgram* program);
+			bool validate() const;
+			void destroy();
+
+
+			const ShaderProgram* getStageProgram(ShaderStage::Stage stage) const;
+			uint32_t getHandle() const;
+			bool isValid() const;
+
+
+			~ShaderPipeline();
+
+
+			static void bind(const ShaderPipeline* pipeline);
+
+		private:
+
+			void _applySubroutines() const;
+
+			static constexpr uint8_t _stageCount = std::countr_zero(static_cast<uint32_t>(ShaderStage::Fragment)) + 1;
+
+			uint32_t _pipeline;
+
+			std::array<const ShaderProgram*, _stageCount> _stagePrograms;
+			std::array<uint32_t, _stageCount> _stageProgramHandles;
+
+		friend class ShaderProgram;
+	};
+}
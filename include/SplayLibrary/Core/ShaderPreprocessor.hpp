@@ -0,0 +1,79 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2021-2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <SplayLibrary/Core/CoreTypes.hpp>
+
+namespace spl
+{
+	/*
+
+	Front end for GLSL sources, resolving "#include" directives (relative to the including file, then in the include
+	directories), honoring "#pragma once", and injecting a set of defines after the "#version" line. Each file gets its
+	own source string number in "#line" directives, in the order of the dependencies returned by "preprocess".
+
+	"getModule" compiles each variant once: modules are cached by their stage and preprocessed source. The
+	files are only read the first time a stage, file and set of defines is requested, later requests are answered from
+	a cache keyed on the file and the permutation key of the defines. "clearModules" must be called to take changes in
+	the files into account.
+
+	*/
+	class SPL_API ShaderPreprocessor
+	{
+		public:
+
+			ShaderPreprocessor();
+			ShaderPreprocessor(const ShaderPreprocessor& preprocessor) = delete;
+			ShaderPreprocessor(ShaderPreprocessor&& preprocessor) = delete;
+
+			ShaderPreprocessor& operator=(const ShaderPreprocessor& preprocessor) = delete;
+			ShaderPreprocessor& operator=(ShaderPreprocessor&& preprocessor) = delete;
+
+
+			void addIncludeDirectory(const std::filesystem::path& directory);
+
+			bool preprocess(const std::filesystem::path& glslFile, const std::map<std::string, std::string>& defines, std::string& source, std::vector<std::filesystem::path>* dependencies = nullptr) const;
+			const ShaderModule* getModule(ShaderStage::Stage stage, const std::filesystem::path& glslFile, const std::map<std::string, std::string>& defines = {});
+
+			void clearModules();
+
+
+			const std::vector<std::filesystem::path>& getIncludeDirectories() const;
+			uint32_t getModuleCount() const;
+
+
+			~ShaderPreprocessor() = default;
+
+
+			static uint64_t computePermutationKey(const std::map<std::string, std::string>& defines);
+
+		private:
+
+			struct PreprocessingState
+			{
+				std::vector<std::filesystem::path> files = {};
+				std::vector<std::string> includeStack = {};
+				std::unordered_set<std::string> pragmaOnceFiles = {};
+			};
+
+			struct ModuleEntry
+			{
+				ShaderStage::Stage stage = ShaderStage::None;
+				std::string source = {};
+
+				std::unique_ptr<ShaderModule> module = nullptr;
+			};
+
+			bool _preprocessFile(const std::filesystem::path& path, PreprocessingState& state, std::string& source) const;
+			bool _resolveInclude(const std::filesystem::path& includingFile, const std::string& name, bool isQuoted, std::filesystem::path& path) const;
+
+			std::vector<std::filesystem::path> _includeDirectories;
+			std::unordered_multimap<uint64_t, ModuleEntry> _modules;	// Entries by hash of their stage and source
+			std::map<std::tuple<ShaderStage::Stage, std::string, uint64_t>, const ShaderModule*> _permutations;
+	};
+}
@@ -17,7 +17,9 @@ namespace spl
 		{
 			None				= 0,
 			Separable			= 1 << 0,
-			BinaryRetrievable	= 1 << 1
+			BinaryRetrievable	= 1 << 1,
+			NoIntrospection		= 1 << 2,
+			EagerUniforms		= 1 << 3
 		};
 	}
 
@@ -208,6 +210,44 @@ namespace spl
 		bool isPerPatch = false;
 	};
 
+	/*
+
+	Name of a program resource, identified by its 64-bit FNV-1a hash. With the "_u" literal (e.g. "model"_u) the hash is
+	computed at compile time, so looking up a resource does not hash any string at runtime.
+
+	*/
+	struct Name
+	{
+		constexpr explicit Name(std::string_view name);
+
+		uint64_t hash;
+	};
+
+	consteval Name operator""_u(const char* name, std::size_t size);
+
+	struct ShaderProgramResourceLocation
+	{
+		uint64_t nameHash = 0;
+		uint32_t resourceIndex = -1;
+		uint32_t arrayElement = 0;
+
+		uint32_t location = -1;
+		uint32_t locationIndex = -1;
+	};
+
+	/*
+
+	Uniform resolved once with ShaderProgram::getUniformHandle, to set it without any name lookup. A handle is only
+	meaningful for the program it was obtained from, and is invalidated when this program is recreated.
+
+	*/
+	struct UniformHandle
+	{
+		int32_t location = -1;
+		GlslType type = GlslType::Undefined;
+		uint32_t arraySize = 0;
+	};
+
 	class SPL_API ShaderProgram
 	{
 		public:
@@ -219,6 +259,7 @@ namespace spl
 			ShaderProgram(const std::filesystem::path& glslVertex, const std::filesystem::path& glslTessControl, const std::filesystem::path& glslTessEval, const std::filesystem::path& glslFragment, ShaderProgramFlags::Flags flags = ShaderProgramFlags::None);
 			ShaderProgram(const std::filesystem::path& glslVertex, const std::filesystem::path& glslTessControl, const std::filesystem::path& glslTessEval, const std::filesystem::path& glslGeometry, const std::filesystem::path& glslFragment, ShaderProgramFlags::Flags flags = ShaderProgramFlags::None);
 			ShaderProgram(const ShaderModule* const* shaders, uint8_t count, ShaderProgramFlags::Flags flags = ShaderProgramFlags::None);
+			ShaderProgram(const ShaderBinary& binary, ShaderProgramFlags::Flags flags = ShaderProgramFlags::None);
 			ShaderProgram(const ShaderProgram& program) = delete;
 			ShaderProgram(ShaderProgram&& program) = delete;
 
@@ -232,8 +273,11 @@ namespace spl
 			bool createFromGlsl(const std::filesystem::path& glslVertex, const std::filesystem::path& glslTessControl, const std::filesystem::path& glslTessEval, const std::filesystem::path& glslFragment, ShaderProgramFlags::Flags flags = ShaderProgramFlags::None);
 			bool createFromGlsl(const std::filesystem::path& glslVertex, const std::filesystem::path& glslTessControl, const std::filesystem::path& glslTessEval, const std::filesystem::path& glslGeometry, const std::filesystem::path& glslFragment, ShaderProgramFlags::Flags flags = ShaderProgramFlags::None);
 			bool createFromShaderModules(const ShaderModule* const* shaders, uint16_t count, ShaderProgramFlags::Flags = ShaderProgramFlags::None);
-			// TODO: Handle binary with a new class "ShaderBinary"
-			// TODO: Handle pipelines with a new class "ShaderPipeline"
+			bool createFromBinary(const ShaderBinary& binary, ShaderProgramFlags::Flags flags = ShaderProgramFlags::None);
+
+			void createFromShaderModulesAsync(const ShaderModule* const* shaders, uint16_t count, ShaderProgramFlags::Flags flags = ShaderProgramFlags::None);
+			bool isLinkingComplete() const;
+			bool waitLinking();
 
 			void destroy();
 
@@ -241,6 +285,12 @@ namespace spl
 			const ShaderProgramInterfaceInfos& getInterfaceInfos(ShaderProgramInterface programInterface) const;
 			const ShaderProgramResourceInfos& getResourceInfos(ShaderProgramInterface programInterface, uint32_t index) const;
 
+			void serializeIntrospection(std::vector<uint8_t>& data, uint64_t key) const;
+			bool deserializeIntrospection(const void* data, uint64_t size, uint64_t key);
+
+
+			UniformHandle getUniformHandle(const std::string& name) const;
+			UniformHandle getUniformHandle(Name name) const;
 
 			template<CGlslScalarType TScalar> void setUniform(const std::string& name, const TScalar& scalar) const;
 			template<CGlslScalarType TScalar> void setUniform(const std::string& name, const TScalar* scalars, uint32_t count) const;
@@ -249,15 +299,43 @@ namespace spl
 			template<CGlslMatType TMat> void setUniform(const std::string& name, const TMat& mat) const;
 			template<CGlslMatType TMat> void setUniform(const std::string& name, const TMat* mats, uint32_t count) const;
 			void setUniform(const std::string& name, uint32_t textureUnit, const Texture* texture) const;
-			// TODO: Image textures (and not just sampled textures)
+			template<CGlslScalarType TScalar> void setUniform(Name name, const TScalar& scalar) const;
+			template<CGlslScalarType TScalar> void setUniform(Name name, const TScalar* scalars, uint32_t count) const;
+			template<CGlslVecType TVec> void setUniform(Name name, const TVec& vec) const;
+			template<CGlslVecType TVec> void setUniform(Name name, const TVec* vecs, uint32_t count) const;
+			template<CGlslMatType TMat> void setUniform(Name name, const TMat& mat) const;
+			template<CGlslMatType TMat> void setUniform(Name name, const TMat* mats, uint32_t count) const;
+			void setUniform(Name name, uint32_t textureUnit, const Texture* texture) const;
+			template<CGlslScalarType TScalar> void setUniform(const UniformHandle& handle, const TScalar& scalar) const;
+			template<CGlslScalarType TScalar> void setUniform(const UniformHandle& handle, const TScalar* scalars, uint32_t count) const;
+			template<CGlslVecType TVec> void setUniform(const UniformHandle& handle, const TVec& vec) const;
+			template<CGlslVecType TVec> void setUniform(const UniformHandle& handle, const TVec* vecs, uint32_t count) const;
+			template<CGlslMatType TMat> void setUniform(const UniformHandle& handle, const TMat& mat) const;
+			template<CGlslMatType TMat> void setUniform(const UniformHandle& handle, const TMat* mats, uint32_t count) const;
+			void setUniform(const UniformHandle& handle, uint32_t textureUnit, const Texture* texture) const;
+			void setUniform(const std::string& name, uint32_t imageUnit, const Texture* texture, ImageAccess access, TextureInternalFormat format = TextureInternalFormat::Undefined) const;
+			void setUniform(Name name, uint32_t imageUnit, const Texture* texture, ImageAccess access, TextureInternalFormat format = TextureInternalFormat::Undefined) const;
+			void setUniform(const UniformHandle& handle, uint32_t imageUnit, const Texture* texture, ImageAccess access, TextureInternalFormat format = TextureInternalFormat::Undefined) const;
+
+			void setSubroutine(ShaderStage::Stage stage, const std::string& subroutineUniform, const std::string& subroutine) const;
+			void setSubroutine(ShaderStage::Stage stage, Name subroutineUniform, Name subroutine) const;
+			void setSubroutines(ShaderStage::Stage stage, const Name* subroutineUniforms, const Name* subroutines, uint32_t count) const;
 
 
 			void setUniformBlockBinding(uint32_t shaderBindingIndex, uint32_t bufferBindingIndex) const;
 			void setShaderStorageBlockBinding(uint32_t shaderBindingIndex, uint32_t bufferBindingIndex) const;
 
 
+			void dispatch(const scp::u32vec3& groups) const;
+			void dispatchIndirect(const Buffer& buffer, uintptr_t offset = 0) const;
+			scp::u32vec3 computeGroupCount(const scp::u32vec3& invocations) const;
+
+
 			uint32_t getHandle() const;
 			ShaderProgramFlags::Flags getFlags() const;
+			const scp::u32vec3& getComputeWorkGroupSize() const;
+			uint64_t getUniformCacheHitCount() const;
+			uint64_t getUniformCacheMissCount() const;
 			bool isValid() const;
 
 
@@ -268,19 +346,52 @@ namespace spl
 
 		private:
 
-			void _shaderIntrospection();
-			void _setUniform(const std::string& name, GlslType type, const void* values, uint32_t count) const;
+			void _shaderIntrospection(ShaderProgramInterface programInterface) const;
+			const ShaderProgramResourceLocation* _findResourceLocation(ShaderProgramInterface programInterface, uint64_t nameHash) const;
+			void _createUniformShadow() const;
+			void _swap(ShaderProgram& program);
+			void _setUniform(const UniformHandle& handle, GlslType type, const void* values, uint32_t count) const;
+			void _copyUniformValues(const ShaderProgram& program) const;
+			bool _selectSubroutine(uint8_t stageIndex, Name subroutineUniform, Name subroutine) const;
+			void _createDefaultSubroutineSelection(uint8_t stageIndex) const;
+			void _copySubroutineSelections(const ShaderProgram& program) const;
+			void _applySubroutines(uint8_t stageIndex) const;
 
 			static constexpr uint8_t _interfaceCount = 21;
+			static constexpr uint8_t _stageCount = 6;
+			static constexpr int32_t _linkPending = -1;
+			static constexpr uint32_t _introspectionMagic = 0x524C5053;	// "SPLR"
+			static constexpr uint32_t _introspectionVersion = 2;
 
 			uint32_t _program;
 			ShaderProgramFlags::Flags _flags;
 			int32_t _linkStatus;
 
-			std::array<ShaderProgramInterfaceInfos, _interfaceCount> _interfacesInfos;
-			std::array<std::vector<ShaderProgramResourceInfos>, _interfaceCount> _resourcesInfos;
+			// Introspection is done lazily, one interface at a time, on the first access
+
+			mutable std::bitset<_interfaceCount> _introspectedInterfaces;
+			mutable std::array<ShaderProgramInterfaceInfos, _interfaceCount> _interfacesInfos;
+			mutable std::array<std::vector<ShaderProgramResourceInfos>, _interfaceCount> _resourcesInfos;
+
+			mutable std::array<std::vector<ShaderProgramResourceLocation>, _interfaceCount> _locations;	// Open addressing tables
+
+			// Copy of the default uniform block, indexed by uniform location, to skip redundant uploads
+
+			mutable std::vector<uint8_t> _uniformShadow;
+			mutable std::vector<uint32_t> _uniformShadowOffsets;
+			mutable std::vector<bool> _uniformShadowInitialized;
+			mutable uint64_t _uniformCacheHitCount;
+			mutable uint64_t _uniformCacheMissCount;
+
+			// Selected subroutine index of each subroutine uniform location, per stage. GL resets them at each
+			// glUseProgram, so they are applied again in "bind".
+
+			mutable std::array<std::vector<uint32_t>, _stageCount> _subroutineSelections;
+
+			mutable scp::u32vec3 _computeWorkGroupSize;	// Local size of the compute stage, queried on first use
 
-			std::array<std::unordered_map<std::string, uint32_t>, _interfaceCount> _locations;
-			std::array<std::unordered_map<std::string, uint32_t>, _interfaceCount> _locationIndices;
+		friend class ShaderPipeline;
+		friend class ShaderReloader;
+		friend class ShaderSpecializer;
 	};
 }
@@ -0,0 +1,86 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2021-2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <SplayLibrary/Core/CoreTypes.hpp>
+
+namespace spl
+{
+	/*
+
+	Hot-reload of programs built from GLSL files. A background thread watches the files of the programs (with inotify on
+	Linux, by polling their modification time elsewhere). "update" must be called between two frames: it submits the
+	asynchronous compilation of the programs whose files changed, and swaps the new GL program into the watched
+	ShaderProgram once it is linked. If the compilation fails, the errors are reported through the debug output and the
+	previous program is kept.
+
+	The files are preprocessed with a ShaderPreprocessor using the include directories and defines given to the reloader,
+	and every file they include is watched too.
+
+	A reload keeps the uniform values and subroutine selections set on the program, matched by name. It invalidates the
+	uniform handles of the program however, and pipelines using it must set their stages again.
+
+	*/
+	class SPL_API ShaderReloader
+	{
+		public:
+
+			ShaderReloader();
+			ShaderReloader(const ShaderReloader& reloader) = delete;
+			ShaderReloader(ShaderReloader&& reloader) = delete;
+
+			ShaderReloader& operator=(const ShaderReloader& reloader) = delete;
+			ShaderReloader& operator=(ShaderReloader&& reloader) = delete;
+
+
+			void addIncludeDirectory(const std::filesystem::path& directory);
+			void watch(ShaderProgram* program, const ShaderStage::Stage* stages, const std::filesystem::path* glslFiles, uint8_t count, ShaderProgramFlags::Flags flags = ShaderProgramFlags::None, const std::map<std::string, std::string>& defines = {});
+			void addDependency(const ShaderProgram* program, const std::filesystem::path& path);
+			void unwatch(const ShaderProgram* program);
+
+			uint32_t update();
+
+
+			~ShaderReloader();
+
+		private:
+
+			struct WatchedProgram
+			{
+				ShaderProgram* program = nullptr;
+				ShaderProgramFlags::Flags flags = ShaderProgramFlags::None;
+				std::vector<ShaderStage::Stage> stages = {};
+				std::vector<std::string> glslFiles = {};
+				std::map<std::string, std::string> defines = {};
+				std::vector<std::string> dependencies = {};
+				std::vector<std::string> includedFiles = {};
+
+				bool reloadRequested = false;
+				std::unique_ptr<ShaderModule[]> pendingModules = nullptr;
+				std::unique_ptr<ShaderProgram> pendingProgram = nullptr;
+			};
+
+			WatchedProgram* _findProgram(const ShaderProgram* program);
+			void _watchPath(const std::string& path);
+			bool _preprocess(WatchedProgram& watchedProgram, uint8_t index, std::string& source);
+			void _submitReload(WatchedProgram& watchedProgram);
+			void _watcherLoop();
+
+			ShaderPreprocessor _preprocessor;
+			std::vector<WatchedProgram> _programs;
+
+			std::mutex _mutex;
+			std::unordered_map<std::string, std::filesystem::file_time_type> _watchedPaths;
+			std::unordered_map<int32_t, std::string> _watchedDirectories;
+			std::unordered_set<std::string> _changedPaths;
+
+			int32_t _inotify;
+			std::atomic<bool> _stopWatcher;
+			std::thread _watcherThread;
+	};
+}
@@ -0,0 +1,107 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2021-2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <SplayLibrary/Core/CoreTypes.hpp>
+
+namespace spl
+{
+	/*
+
+	Specialization of a program built from GLSL files on the values of some of its scalar uniforms (light counts,
+	feature toggles...). The values of these candidates are set through "setUniform". Once a candidate kept the same
+	value for "stableFrameCount" calls to "update", a variant of the program is compiled asynchronously, with the
+	value injected as a define, and swapped into the program when it is linked. If the value of a specialized candidate
+	changes, the generic program (kept linked meanwhile) is swapped back before the new value is used.
+
+	The files are preprocessed with the given ShaderPreprocessor and defines, that must be the ones the program was
+	built with, and the variants are linked with the flags of the program.
+
+	Shaders opt in by declaring the candidates as follows:
+
+		#ifdef SPL_SPECIALIZED_lightCount
+			const int lightCount = SPL_SPECIALIZED_lightCount;
+		#else
+			uniform int lightCount;
+		#endif
+
+	The values of the other uniforms are copied at each swap. As with ShaderReloader, a swap invalidates the uniform
+	handles of the program and the uniform block bindings set at runtime, and pipelines using it must set their stages
+	again. "update" returns true when the program was swapped: the uniform handles cached by the caller must then be
+	fetched again.
+
+	*/
+	class SPL_API ShaderSpecializer
+	{
+		public:
+
+			ShaderSpecializer();
+			ShaderSpecializer(ShaderProgram* program, const ShaderStage::Stage* stages, const std::filesystem::path* glslFiles, uint8_t count, const ShaderPreprocessor* preprocessor = nullptr, const std::map<std::string, std::string>& defines = {});
+			ShaderSpecializer(const ShaderSpecializer& specializer) = delete;
+			ShaderSpecializer(ShaderSpecializer&& specializer) = delete;
+
+			ShaderSpecializer& operator=(const ShaderSpecializer& specializer) = delete;
+			ShaderSpecializer& operator=(ShaderSpecializer&& specializer) = delete;
+
+
+			bool createFromGlsl(ShaderProgram* program, const ShaderStage::Stage* stages, const std::filesystem::path* glslFiles, uint8_t count, const ShaderPreprocessor* preprocessor = nullptr, const std::map<std::string, std::string>& defines = {});
+			void addCandidate(const std::string& name);
+			void setStableFrameCount(uint32_t frameCount);
+			void destroy();
+
+			template<CGlslScalarType TScalar> void setUniform(const std::string& name, const TScalar& scalar);
+			template<CGlslScalarType TScalar> void setUniform(Name name, const TScalar& scalar);
+
+			bool update();
+
+
+			const ShaderProgram* getProgram() const;
+			bool isSpecialized() const;
+			uint32_t getVariantCount() const;
+			bool isValid() const;
+
+
+			~ShaderSpecializer();
+
+		private:
+
+			struct Candidate
+			{
+				std::string name = {};
+				uint64_t nameHash = 0;
+
+				GlslType type = GlslType::Undefined;
+				uint64_t value = 0;				// Value as uploaded with glProgramUniform (bools as int)
+				std::string literal = {};		// GLSL literal of the value, empty if it cannot be specialized
+				uint32_t stableFrames = 0;
+
+				std::string specializedLiteral = {};	// Literal in the current program, empty if it is a uniform there
+				std::string pendingLiteral = {};		// Literal in the pending variant
+			};
+
+			bool _setCandidate(uint64_t nameHash, GlslType type, const void* value);
+			void _applyCandidate(const Candidate& candidate) const;
+			void _submitVariant(const std::string& defines);
+			void _swapProgram(ShaderProgram& program);
+			void _restoreGenericProgram();
+
+			ShaderProgram* _program;
+			std::vector<ShaderStage::Stage> _stages;
+			std::vector<std::string> _sources;
+
+			std::vector<Candidate> _candidates;
+			uint32_t _stableFrameCount;
+
+			std::unique_ptr<ShaderProgram> _genericProgram;	// Generic program while a variant is swapped in
+			std::unique_ptr<ShaderModule[]> _pendingModules;
+			std::unique_ptr<ShaderProgram> _pendingProgram;
+			std::string _pendingDefines;
+			std::string _failedDefines;
+			uint32_t _variantCount;
+	};
+}
@@ -0,0 +1,75 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2021-2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <SplayLibrary/Core/CoreTypes.hpp>
+
+namespace spl
+{
+	/*
+
+	Cache of specialized SPIR-V modules. Each SPIR-V file is mapped in memory (read once on platforms without mmap) and
+	hashed the first time it is requested. Modules are identified by the hash of the file, the stage, the entry point
+	and the specialization constants (compared in full, not only through a hash of them), so creating a variant already
+	requested does not touch the disk nor the driver.
+
+	The modules are owned by the cache and can be shared by several programs.
+
+	*/
+	class SPL_API SpirVModuleCache
+	{
+		public:
+
+			SpirVModuleCache();
+			SpirVModuleCache(const SpirVModuleCache& cache) = delete;
+			SpirVModuleCache(SpirVModuleCache&& cache) = delete;
+
+			SpirVModuleCache& operator=(const SpirVModuleCache& cache) = delete;
+			SpirVModuleCache& operator=(SpirVModuleCache&& cache) = delete;
+
+
+			const ShaderModule* getModule(ShaderStage::Stage stage, const std::filesystem::path& spirvFile, const char* entryPoint = "main", const uint32_t* constantIndices = nullptr, const void* constantValues = nullptr, uint32_t specializationConstantsCount = 0);
+
+			void clear();
+
+
+			uint32_t getFileCount() const;
+			uint32_t getModuleCount() const;
+
+
+			~SpirVModuleCache();
+
+		private:
+
+			struct MappedFile
+			{
+				const void* data = nullptr;
+				uint64_t size = 0;
+				uint64_t hash = 0;
+
+				std::vector<uint8_t> content = {};
+			};
+
+			struct Entry
+			{
+				uint64_t fileHash = 0;
+				ShaderStage::Stage stage = ShaderStage::None;
+				std::string entryPoint = {};
+				std::vector<uint32_t> constantIndices = {};
+				std::vector<uint32_t> constantValues = {};
+
+				std::unique_ptr<ShaderModule> module = nullptr;
+			};
+
+			const MappedFile* _mapFile(const std::filesystem::path& spirvFile);
+			static void _unmapFile(MappedFile& file);
+
+			std::unordered_map<std::string, MappedFile> _files;
+			std::unordered_multimap<uint64_t, Entry> _modules;	// Entries by hash of their key
+	};
+}
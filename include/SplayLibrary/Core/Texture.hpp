@@ -234,6 +234,25 @@ namespace spl
 		uint32_t level = 0;
 	};
 
+	enum class ImageAccess
+	{
+		ReadOnly,
+		WriteOnly,
+		ReadWrite
+	};
+
+	struct ImageUnitBinding
+	{
+		const Texture* texture = nullptr;
+		uint32_t level = 0;
+		bool isLayered = false;
+		uint32_t layer = 0;
+		ImageAccess access = ImageAccess::ReadOnly;
+		TextureInternalFormat format = TextureInternalFormat::Undefined;
+
+		bool operator==(const ImageUnitBinding& binding) const = default;
+	};
+
 	class SPL_API Texture : public FramebufferAttachable
 	{
 		public:
@@ -252,6 +271,8 @@ namespace spl
 			// TODO: glClearTexSubImage
 			// TODO: glInvalidateTexSubImage
 			// TODO: Texture views (new class that Texture inherits from ?)
+			void setLabel(const std::string& label);
+
 			void destroy();
 
 
@@ -271,7 +292,10 @@ namespace spl
 
 			bool isValid() const;
 			uint32_t getHandle() const;
+			uint64_t getBindlessHandle(const Sampler* sampler = nullptr) const;	// The texture and sampler states cannot change once a handle is created
 			const TextureCreationParams& getCreationParams() const;
+			const std::string& getLabel() const;
+			uint64_t getMemorySize() const;
 
 			const scp::f32vec4& getBorderColor() const;
 			TextureCompareMode getCompareMode() const;
@@ -292,6 +316,8 @@ namespace spl
 
 			static void bind(const Texture* texture, uint32_t textureUnit);
 			static void bind(const Texture* const* textures, uint32_t firstUnit, uint32_t count);
+			static void bindImage(const Texture* texture, uint32_t imageUnit, ImageAccess access, TextureInternalFormat format = TextureInternalFormat::Undefined, uint32_t level = 0, int32_t layer = -1);
+			static void bindImages(const Texture* const* textures, uint32_t firstUnit, uint32_t count);
 
 		protected:
 
@@ -330,5 +356,14 @@ namespace spl
 			TextureWrapping _sWrap;
 			TextureWrapping _tWrap;
 			TextureWrapping _rWrap;
+
+			std::string _label;
+
+			mutable std::vector<std::pair<Context*, uint32_t>> _contextBindings;	// Units of the contexts the texture is bound to
+			mutable std::vector<std::pair<Context*, uint32_t>> _contextImageBindings;
+			mutable uint64_t _shaderWriteEpoch;
+			mutable bool _hasBindlessHandle;	// Sampling parameters cannot be changed anymore
+
+		friend class Context;
 	};
 }
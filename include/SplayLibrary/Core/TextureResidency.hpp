@@ -0,0 +1,65 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2021-2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <SplayLibrary/Core/CoreTypes.hpp>
+
+namespace spl
+{
+	/*
+
+	Reference counted residency of bindless texture handles (ARB_bindless_texture). "acquire" returns the handle of a
+	texture (and optional sampler) and makes it resident in the current context on its first acquisition, "release"
+	makes it non-resident when its last user releases it. Destroying a texture drops its handles, while handles created
+	with a sampler stay valid after the destruction of this sampler.
+
+	Creating a handle makes the sampling parameters (filtering, wrapping, LOD, border color...) of the texture immutable,
+	and those of the sampler too if one is given: their setters must not be called anymore.
+
+	When the extension is not supported, "acquire" returns 0 and the textures must be bound to texture units instead.
+
+	*/
+	class SPL_API TextureResidency
+	{
+		public:
+
+			TextureResidency() = delete;
+			TextureResidency(const TextureResidency& residency) = delete;
+			TextureResidency(TextureResidency&& residency) = delete;
+
+			TextureResidency& operator=(const TextureResidency& residency) = delete;
+			TextureResidency& operator=(TextureResidency&& residency) = delete;
+
+
+			static uint64_t acquire(const Texture& texture, const Sampler* sampler = nullptr);
+			static void release(uint64_t handle);
+
+
+			static bool isSupported();
+			static bool isResident(uint64_t handle);
+			static uint32_t getResidentCount();
+
+
+			~TextureResidency() = default;
+
+		private:
+
+			struct Entry
+			{
+				const Texture* texture;
+				uint32_t refCount;
+			};
+
+			static void _forget(const Texture* texture);
+
+			static std::mutex _mutex;
+			static std::map<std::pair<const Context*, uint64_t>, Entry> _entries;	// Residency is per context
+
+		friend class Texture;
+	};
+}
@@ -37,6 +37,26 @@ namespace spl
 		UnsignedInt
 	};
 
+	// Layouts of the commands read from a BufferTarget::DrawIndirect buffer. Unlike "drawElements", the first index is
+	// a number of indices and not an offset in bytes.
+
+	struct DrawArraysCommand
+	{
+		uint32_t count = 0;
+		uint32_t instanceCount = 1;
+		uint32_t first = 0;
+		uint32_t baseInstance = 0;
+	};
+
+	struct DrawElementsCommand
+	{
+		uint32_t count = 0;
+		uint32_t instanceCount = 1;
+		uint32_t firstIndex = 0;
+		int32_t baseVertex = 0;
+		uint32_t baseInstance = 0;
+	};
+
 	class SPL_API VertexArray
 	{
 		public:
@@ -63,7 +83,12 @@ namespace spl
 			void drawElements(PrimitiveType primitiveType, IndexType indexType, uintptr_t first, uint32_t count, uint32_t instanceCount = 1, uint32_t baseInstance = 0, uint32_t baseVertex = 0) const;
 			void multiDrawArrays(PrimitiveType type, const uint32_t* firsts, const uint32_t* counts, uint32_t drawCount) const;
 			void multiDrawElements(PrimitiveType primitiveType, IndexType indexType, const uintptr_t* firsts, const uint32_t* counts, uint32_t drawCount, const uint32_t* baseVertex = nullptr) const;
-			// TODO: indirect
+			void drawArraysIndirect(PrimitiveType type, const Buffer& buffer, uintptr_t offset = 0) const;
+			void drawElementsIndirect(PrimitiveType primitiveType, IndexType indexType, const Buffer& buffer, uintptr_t offset = 0) const;
+			void multiDrawArraysIndirect(PrimitiveType type, const Buffer& buffer, uint32_t drawCount, uintptr_t offset = 0, uint32_t stride = sizeof(DrawArraysCommand)) const;
+			void multiDrawElementsIndirect(PrimitiveType primitiveType, IndexType indexType, const Buffer& buffer, uint32_t drawCount, uintptr_t offset = 0, uint32_t stride = sizeof(DrawElementsCommand)) const;
+			void multiDrawArraysIndirectCount(PrimitiveType type, const Buffer& buffer, const Buffer& countBuffer, uint32_t maxDrawCount, uintptr_t offset = 0, uintptr_t countOffset = 0, uint32_t stride = sizeof(DrawArraysCommand)) const;
+			void multiDrawElementsIndirectCount(PrimitiveType primitiveType, IndexType indexType, const Buffer& buffer, const Buffer& countBuffer, uint32_t maxDrawCount, uintptr_t offset = 0, uintptr_t countOffset = 0, uint32_t stride = sizeof(DrawElementsCommand)) const;
 
 			uint32_t getHandle() const;
 
@@ -71,6 +96,14 @@ namespace spl
 
 		private:
 
+			void _bindIndirectBuffer(const Buffer& buffer) const;
+			void _bindParameterBuffer(const Buffer& buffer) const;
+
 			uint32_t _vao;
+
+			const Buffer* _elementBuffer;
+			std::vector<const Buffer*> _arrayBuffers;	// Only used to find the buffers written by shaders before a draw
+
+		friend class Context;
 	};
 }
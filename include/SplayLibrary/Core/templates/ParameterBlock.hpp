@@ -0,0 +1,86 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2021-2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <SplayLibrary/Core/CoreDecl.hpp>
+#include <SplayLibrary/Private/PrivateIncluded.hpp>
+
+namespace spl
+{
+	template<CGlslScalarType TScalar>
+	void ParameterBlock::set(const std::string& name, const TScalar& scalar)
+	{
+		set(Name(name), scalar);
+	}
+
+	template<CGlslScalarType TScalar>
+	void ParameterBlock::set(const std::string& name, const TScalar* scalars, uint32_t count)
+	{
+		set(Name(name), scalars, count);
+	}
+
+	template<CGlslVecType TVec>
+	void ParameterBlock::set(const std::string& name, const TVec& vec)
+	{
+		set(Name(name), vec);
+	}
+
+	template<CGlslVecType TVec>
+	void ParameterBlock::set(const std::string& name, const TVec* vecs, uint32_t count)
+	{
+		set(Name(name), vecs, count);
+	}
+
+	template<CGlslMatType TMat>
+	void ParameterBlock::set(const std::string& name, const TMat& mat)
+	{
+		set(Name(name), mat);
+	}
+
+	template<CGlslMatType TMat>
+	void ParameterBlock::set(const std::string& name, const TMat* mats, uint32_t count)
+	{
+		set(Name(name), mats, count);
+	}
+
+	template<CGlslScalarType TScalar>
+	void ParameterBlock::set(Name name, const TScalar& scalar)
+	{
+		_set(name.hash, _spl::glslScalarTypeToGlslType<TScalar>(), &scalar, 1);
+	}
+
+	template<CGlslScalarType TScalar>
+	void ParameterBlock::set(Name name, const TScalar* scalars, uint32_t count)
+	{
+		_set(name.hash, _spl::glslScalarTypeToGlslType<TScalar>(), scalars, count);
+	}
+
+	template<CGlslVecType TVec>
+	void ParameterBlock::set(Name name, const TVec& vec)
+	{
+		_set(name.hash, _spl::glslVecTypeToGlslType<TVec>(), &vec, 1);
+	}
+
+	template<CGlslVecType TVec>
+	void ParameterBlock::set(Name name, const TVec* vecs, uint32_t count)
+	{
+		_set(name.hash, _spl::glslVecTypeToGlslType<TVec>(), vecs, count);
+	}
+
+	template<CGlslMatType TMat>
+	void ParameterBlock::set(Name name, const TMat& mat)
+	{
+		_set(name.hash, _spl::glslMatTypeToGlslType<TMat>(), &mat, 1);
+	}
+
+	template<CGlslMatType TMat>
+	void ParameterBlock::set(Name name, const TMat* mats, uint32_t count)
+	{
+		_set(name.hash, _spl::glslMatTypeToGlslType<TMat>(), mats, count);
+	}
+}
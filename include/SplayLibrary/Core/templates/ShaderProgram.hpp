@@ -12,24 +12,106 @@
 
 namespace spl
 {
+	constexpr Name::Name(std::string_view name) :
+		hash(_spl::fnv1a(name.data(), name.size()))
+	{
+	}
+
+	consteval Name operator""_u(const char* name, std::size_t size)
+	{
+		return Name(std::string_view(name, size));
+	}
+
 	template<CGlslScalarType TScalar>
 	void ShaderProgram::setUniform(const std::string& name, const TScalar& scalar) const
+	{
+		setUniform(getUniformHandle(name), scalar);
+	}
+
+	template<CGlslScalarType TScalar>
+	void ShaderProgram::setUniform(const std::string& name, const TScalar* scalars, uint32_t count) const
+	{
+		setUniform(getUniformHandle(name), scalars, count);
+	}
+
+	template<CGlslVecType TVec>
+	void ShaderProgram::setUniform(const std::string& name, const TVec& vec) const
+	{
+		setUniform(getUniformHandle(name), vec);
+	}
+
+	template<CGlslVecType TVec>
+	void ShaderProgram::setUniform(const std::string& name, const TVec* vecs, uint32_t count) const
+	{
+		setUniform(getUniformHandle(name), vecs, count);
+	}
+
+	template<CGlslMatType TMat>
+	void ShaderProgram::setUniform(const std::string& name, const TMat& mat) const
+	{
+		setUniform(getUniformHandle(name), mat);
+	}
+
+	template<CGlslMatType TMat>
+	void ShaderProgram::setUniform(const std::string& name, const TMat* mats, uint32_t count) const
+	{
+		setUniform(getUniformHandle(name), mats, count);
+	}
+
+	template<CGlslScalarType TScalar>
+	void ShaderProgram::setUniform(Name name, const TScalar& scalar) const
+	{
+		setUniform(getUniformHandle(name), scalar);
+	}
+
+	template<CGlslScalarType TScalar>
+	void ShaderProgram::setUniform(Name name, const TScalar* scalars, uint32_t count) const
+	{
+		setUniform(getUniformHandle(name), scalars, count);
+	}
+
+	template<CGlslVecType TVec>
+	void ShaderProgram::setUniform(Name name, const TVec& vec) const
+	{
+		setUniform(getUniformHandle(name), vec);
+	}
+
+	template<CGlslVecType TVec>
+	void ShaderProgram::setUniform(Name name, const TVec* vecs, uint32_t count) const
+	{
+		setUniform(getUniformHandle(name), vecs, count);
+	}
+
+	template<CGlslMatType TMat>
+	void ShaderProgram::setUniform(Name name, const TMat& mat) const
+	{
+		setUniform(getUniformHandle(name), mat);
+	}
+
+	template<CGlslMatType TMat>
+	void ShaderProgram::setUniform(Name name, const TMat* mats, uint32_t count) const
+	{
+		setUniform(getUniformHandle(name), mats, count);
+	}
+
+	template<CGlslScalarType TScalar>
+	void ShaderProgram::setUniform(const UniformHandle& handle, const TScalar& scalar) const
 	{
 		static constexpr GlslType type = _spl::glslScalarTypeToGlslType<TScalar>();
 
 		if constexpr (type == GlslType::Bool)
 		{
 			const int32_t buffer = scalar;
-			_setUniform(name, GlslType::Int, &buffer, 1);
+			_setUniform(handle, GlslType::Int, &buffer, 1);
 		}
 		else
 		{
-			_setUniform(name, type, &scalar, 1);
+			_setUniform(handle, type, &scalar, 1);
 		}
 	}
 
 	template<CGlslScalarType TScalar>
-	void ShaderProgram::setUniform(const std::string& name, const TScalar* scalars, uint32_t count) const
+	void ShaderProgram::setUniform(const UniformHandle& handle, const TScalar* scalars, uint32_t count) const
 	{
 		static constexpr GlslType type = _spl::glslScalarTypeToGlslType<TScalar>();
 
@@ -38,42 +120,42 @@ namespace spl
 			std::vector<int32_t> buffer(count);
 			std::copy_n(scalars, count, buffer.begin());
 
-			_setUniform(name, GlslType::Int, buffer.data(), count);
+			_setUniform(handle, GlslType::Int, buffer.data(), count);
 		}
 		else
 		{
-			_setUniform(name, type, scalars, count);
+			_setUniform(handle, type, scalars, count);
 		}
 	}
 
 	template<CGlslVecType TVec>
-	void ShaderProgram::setUniform(const std::string& name, const TVec& vec) const
+	void ShaderProgram::setUniform(const UniformHandle& handle, const TVec& vec) const
 	{
 		static constexpr GlslType type = _spl::glslVecTypeToGlslType<TVec>();
 
 		if constexpr (type == GlslType::BoolVec2)
 		{
 			const int32_t buffer[2] = { vec.x, vec.y };
-			_setUniform(name, GlslType::IntVec2, buffer, 1);
+			_setUniform(handle, GlslType::IntVec2, buffer, 1);
 		}
 		else if constexpr (type == GlslType::BoolVec3)
 		{
 			const int32_t buffer[3] = { vec.x, vec.y, vec.z };
-			_setUniform(name, GlslType::IntVec3, buffer, 1);
+			_setUniform(handle, GlslType::IntVec3, buffer, 1);
 		}
 		else if constexpr (type == GlslType::BoolVec4)
 		{
 			const int32_t buffer[4] = { vec.x, vec.y, vec.z, vec.w };
-			_setUniform(name, GlslType::IntVec4, buffer, 1);
+			_setUniform(handle, GlslType::IntVec4, buffer, 1);
 		}
 		else
 		{
-			_setUniform(name, type, &vec, 1);
+			_setUniform(handle, type, &vec, 1);
 		}
 	}
 
 	template<CGlslVecType TVec>
-	void ShaderProgram::setUniform(const std::string& name, const TVec* vecs, uint32_t count) const
+	void ShaderProgram::setUniform(const UniformHandle& handle, const TVec* vecs, uint32_t count) const
 	{
 		static constexpr GlslType type = _spl::glslVecTypeToGlslType<TVec>();
 
@@ -82,37 +164,37 @@ namespace spl
 			std::vector<int32_t> buffer(2 * count);
 			std::copy_n(reinterpret_cast<const bool*>(vecs), 2 * count, buffer.begin());
 
-			_setUniform(name, GlslType::IntVec2, buffer.data(), count);
+			_setUniform(handle, GlslType::IntVec2, buffer.data(), count);
 		}
 		else if constexpr (type == GlslType::BoolVec3)
 		{
 			std::vector<int32_t> buffer(3 * count);
 			std::copy_n(reinterpret_cast<const bool*>(vecs), 3 * count, buffer.begin());
 
-			_setUniform(name, GlslType::IntVec3, buffer.data(), count);
+			_setUniform(handle, GlslType::IntVec3, buffer.data(), count);
 		}
 		else if constexpr (type == GlslType::BoolVec4)
 		{
 			std::vector<int32_t> buffer(4 * count);
 			std::copy_n(reinterpret_cast<const bool*>(vecs), 4 * count, buffer.begin());
 
-			_setUniform(name, GlslType::IntVec4, buffer.data(), count);
+			_setUniform(handle, GlslType::IntVec4, buffer.data(), count);
 		}
 		else
 		{
-			_setUniform(name, type, vecs, count);
+			_setUniform(handle, type, vecs, count);
 		}
 	}
 
 	template<CGlslMatType TMat>
-	void ShaderProgram::setUniform(const std::string& name, const TMat& mat) const
+	void ShaderProgram::setUniform(const UniformHandle& handle, const TMat& mat) const
 	{
-		_setUniform(name, _spl::glslMatTypeToGlslType<TMat>(), &mat, 1);
+		_setUniform(handle, _spl::glslMatTypeToGlslType<TMat>(), &mat, 1);
 	}
 
 	template<CGlslMatType TMat>
-	void ShaderProgram::setUniform(const std::string& name, const TMat* mats, uint32_t count) const
+	void ShaderProgram::setUniform(const UniformHandle& handle, const TMat* mats, uint32_t count) const
 	{
-		_setUniform(name, _spl::glslMatTypeToGlslType<TMat>(), mats, count);
+		_setUniform(handle, _spl::glslMatTypeToGlslType<TMat>(), mats, count);
 	}
 }
@@ -0,0 +1,31 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2021-2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <SplayLibrary/Core/CoreDecl.hpp>
+#include <SplayLibrary/Private/PrivateIncluded.hpp>
+
+namespace spl
+{
+	template<CGlslScalarType TScalar>
+	void ShaderSpecializer::setUniform(const std::string& name, const TScalar& scalar)
+	{
+		setUniform(Name(name), scalar);
+	}
+
+	template<CGlslScalarType TScalar>
+	void ShaderSpecializer::setUniform(Name name, const TScalar& scalar)
+	{
+		assert(isValid());
+
+		if (!_setCandidate(name.hash, _spl::glslScalarTypeToGlslType<TScalar>(), &scalar))
+		{
+			_program->setUniform(name, scalar);
+		}
+	}
+}
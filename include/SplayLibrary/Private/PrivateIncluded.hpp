@@ -15,15 +15,20 @@ namespace spl
 	{
 		constexpr bool isIndexedBufferTarget(BufferTarget target);
 
+		constexpr uint64_t fnv1a(const char* data, uint64_t size, uint64_t hash = 0xcbf29ce484222325);
+
 		template<CGlslScalarType TScalar> consteval GlslType glslScalarTypeToGlslType();
 		template<CGlslVecType TVec> consteval GlslType glslVecTypeToGlslType();
 		template<CGlslMatType TMat> consteval GlslType glslMatTypeToGlslType();
+		constexpr uint32_t glslTypeToSize(GlslType type);
 
 		template<TextureInternalFormat InternalFormat> struct TextureInternalFormatToColorVecType { using Type = void; };
 		template<CColorVecType TColorVec> struct ColorVecTypeToPixelType { using Type = void; };
 		template<CColorVecType TColorVec> consteval TextureInternalFormat colorVecTypeToTextureInternalFormat();
 		constexpr TextureFormat textureInternalFormatToTextureFormat(TextureInternalFormat internalFormat);
 		constexpr TextureDataType textureInternalFormatToTextureDataType(TextureInternalFormat internalFormat);
+		constexpr uint32_t textureInternalFormatToTexelBits(TextureInternalFormat internalFormat);
+		constexpr bool isImageUnitFormat(TextureInternalFormat internalFormat);
 	}
 }
 
@@ -30,6 +30,7 @@ namespace spl
 		constexpr GLenum textureFormatToGLenum(TextureFormat format);
 		constexpr GLenum textureDataTypeToGLenum(TextureDataType dataType);
 		constexpr GLenum textureInternalFormatToGLenum(TextureInternalFormat internalFormat);
+		constexpr GLenum imageAccessToGLenum(ImageAccess access);
 
 		constexpr GLenum shaderStageToGLenum(ShaderStage::Stage stage);
 		constexpr GLbitfield shaderStageToGLbitfield(ShaderStage::Stage stage);
@@ -51,6 +52,7 @@ namespace spl
 		constexpr ContextProfileMask::Flags glToContextProfileMask(GLbitfield flags);
 		constexpr GLenum blendEquationToGLenum(BlendEquation equation);
 		constexpr GLenum blendFuncToGLenum(BlendFunc func);
+		constexpr GLbitfield memoryBarrierFlagsToGLbitfield(MemoryBarrierFlags::Flags flags);
 	}
 }
 
@@ -13,6 +13,17 @@ namespace spl
 {
 	namespace _spl
 	{
+		constexpr uint64_t fnv1a(const char* data, uint64_t size, uint64_t hash)
+		{
+			for (uint64_t i = 0; i < size; ++i)
+			{
+				hash ^= static_cast<uint8_t>(data[i]);
+				hash *= 0x100000001b3;
+			}
+
+			return hash;
+		}
+
 		constexpr bool isIndexedBufferTarget(BufferTarget target)
 		{
 			switch (target)
@@ -97,6 +108,72 @@ namespace spl
 			else { assert(false); return GlslType::Undefined; }
 		}
 
+		constexpr uint32_t glslTypeToSize(GlslType type)
+		{
+			// Size of the value uploaded with glProgramUniform* (bools, samplers and images are uploaded as int)
+
+			switch (type)
+			{
+				case GlslType::Undefined:
+					assert(false);
+					return 0;
+
+				case GlslType::Float:
+				case GlslType::Int:
+				case GlslType::UnsignedInt:
+				case GlslType::Bool:
+					return 4;
+				case GlslType::FloatVec2:
+				case GlslType::IntVec2:
+				case GlslType::UnsignedIntVec2:
+				case GlslType::BoolVec2:
+				case GlslType::Double:
+					return 8;
+				case GlslType::FloatVec3:
+				case GlslType::IntVec3:
+				case GlslType::UnsignedIntVec3:
+				case GlslType::BoolVec3:
+					return 12;
+				case GlslType::FloatVec4:
+				case GlslType::IntVec4:
+				case GlslType::UnsignedIntVec4:
+				case GlslType::BoolVec4:
+				case GlslType::DoubleVec2:
+				case GlslType::FloatMat2x2:
+					return 16;
+				case GlslType::DoubleVec3:
+				case GlslType::FloatMat2x3:
+				case GlslType::FloatMat3x2:
+					return 24;
+				case GlslType::DoubleVec4:
+				case GlslType::FloatMat2x4:
+				case GlslType::FloatMat4x2:
+				case GlslType::DoubleMat2x2:
+					return 32;
+				case GlslType::FloatMat3x3:
+					return 36;
+				case GlslType::FloatMat3x4:
+				case GlslType::FloatMat4x3:
+				case GlslType::DoubleMat2x3:
+				case GlslType::DoubleMat3x2:
+					return 48;
+				case GlslType::FloatMat4x4:
+				case GlslType::DoubleMat2x4:
+				case GlslType::DoubleMat4x2:
+					return 64;
+				case GlslType::DoubleMat3x3:
+					return 72;
+				case GlslType::DoubleMat3x4:
+				case GlslType::DoubleMat4x3:
+					return 96;
+				case GlslType::DoubleMat4x4:
+					return 128;
+
+				default:
+					return 4;
+			}
+		}
+
 
 		template<> struct TextureInternalFormatToColorVecType<TextureInternalFormat::R_u8>					{ using Type = uint8_t; };
 		template<> struct TextureInternalFormatToColorVecType<TextureInternalFormat::R_i8>					{ using Type = int8_t; };
@@ -448,5 +525,153 @@ namespace spl
 					return TextureDataType::Undefined;
 			}
 		}
+
+		constexpr uint32_t textureInternalFormatToTexelBits(TextureInternalFormat internalFormat)
+		{
+			switch (internalFormat)
+			{
+				case TextureInternalFormat::R_u8:
+				case TextureInternalFormat::R_i8:
+				case TextureInternalFormat::R_nu8:
+				case TextureInternalFormat::R_ni8:
+				case TextureInternalFormat::Stencil_u1:
+				case TextureInternalFormat::Stencil_u4:
+				case TextureInternalFormat::Stencil_u8:
+				case TextureInternalFormat::R_nu3_G_nu3_B_nu2:
+				case TextureInternalFormat::RGBA_nu2:
+					return 8;
+
+				case TextureInternalFormat::R_u16:
+				case TextureInternalFormat::R_i16:
+				case TextureInternalFormat::R_f16:
+				case TextureInternalFormat::R_nu16:
+				case TextureInternalFormat::R_ni16:
+				case TextureInternalFormat::RG_u8:
+				case TextureInternalFormat::RG_i8:
+				case TextureInternalFormat::RG_nu8:
+				case TextureInternalFormat::RG_ni8:
+				case TextureInternalFormat::Depth_nu16:
+				case TextureInternalFormat::Stencil_u16:
+				case TextureInternalFormat::RGB_nu4:
+				case TextureInternalFormat::RGB_nu5:
+				case TextureInternalFormat::R_nu5_G_nu6_B_nu5:
+				case TextureInternalFormat::RGBA_nu4:
+				case TextureInternalFormat::RGB_nu5_A_nu1:
+					return 16;
+
+				case TextureInternalFormat::RGB_u8:
+				case TextureInternalFormat::RGB_i8:
+				case TextureInternalFormat::RGB_nu8:
+				case TextureInternalFormat::RGB_ni8:
+					return 24;
+
+				case TextureInternalFormat::R_u32:
+				case TextureInternalFormat::R_i32:
+				case TextureInternalFormat::R_f32:
+				case TextureInternalFormat::RG_u16:
+				case TextureInternalFormat::RG_i16:
+				case TextureInternalFormat::RG_f16:
+				case TextureInternalFormat::RG_nu16:
+				case TextureInternalFormat::RG_ni16:
+				case TextureInternalFormat::RGBA_u8:
+				case TextureInternalFormat::RGBA_i8:
+				case TextureInternalFormat::RGBA_nu8:
+				case TextureInternalFormat::RGBA_ni8:
+				case TextureInternalFormat::Depth_nu24:		// Depth 24 bits is stored on 32 bits
+				case TextureInternalFormat::Depth_nu32:
+				case TextureInternalFormat::Depth_f32:
+				case TextureInternalFormat::Depth_nu24_Stencil_u8:
+				case TextureInternalFormat::RGB_nu10:
+				case TextureInternalFormat::R_f11_G_f11_B_f10:
+				case TextureInternalFormat::RGB_u10_A_u2:
+				case TextureInternalFormat::RGB_nu10_A_nu2:
+					return 32;
+
+				case TextureInternalFormat::RGB_u16:
+				case TextureInternalFormat::RGB_i16:
+				case TextureInternalFormat::RGB_f16:
+				case TextureInternalFormat::RGB_nu16:
+				case TextureInternalFormat::RGB_ni16:
+				case TextureInternalFormat::RGB_nu12:
+				case TextureInternalFormat::RGBA_nu12:
+					return 48;
+
+				case TextureInternalFormat::RG_u32:
+				case TextureInternalFormat::RG_i32:
+				case TextureInternalFormat::RG_f32:
+				case TextureInternalFormat::RGBA_u16:
+				case TextureInternalFormat::RGBA_i16:
+				case TextureInternalFormat::RGBA_f16:
+				case TextureInternalFormat::RGBA_nu16:
+				case TextureInternalFormat::RGBA_ni16:
+				case TextureInternalFormat::Depth_f32_Stencil_u8:
+					return 64;
+
+				case TextureInternalFormat::RGB_u32:
+				case TextureInternalFormat::RGB_i32:
+				case TextureInternalFormat::RGB_f32:
+					return 96;
+
+				case TextureInternalFormat::RGBA_u32:
+				case TextureInternalFormat::RGBA_i32:
+				case TextureInternalFormat::RGBA_f32:
+					return 128;
+
+				default:
+					assert(false);
+					return 0;
+			}
+		}
+
+		constexpr bool isImageUnitFormat(TextureInternalFormat internalFormat)
+		{
+			// Formats supported by image load/store (table 8.26 of the OpenGL 4.6 specification)
+
+			switch (internalFormat)
+			{
+				case TextureInternalFormat::R_u8:
+				case TextureInternalFormat::R_i8:
+				case TextureInternalFormat::R_nu8:
+				case TextureInternalFormat::R_ni8:
+				case TextureInternalFormat::R_u16:
+				case TextureInternalFormat::R_i16:
+				case TextureInternalFormat::R_f16:
+				case TextureInternalFormat::R_nu16:
+				case TextureInternalFormat::R_ni16:
+				case TextureInternalFormat::R_u32:
+				case TextureInternalFormat::R_i32:
+				case TextureInternalFormat::R_f32:
+				case TextureInternalFormat::RG_u8:
+				case TextureInternalFormat::RG_i8:
+				case TextureInternalFormat::RG_nu8:
+				case TextureInternalFormat::RG_ni8:
+				case TextureInternalFormat::RG_u16:
+				case TextureInternalFormat::RG_i16:
+				case TextureInternalFormat::RG_f16:
+				case TextureInternalFormat::RG_nu16:
+				case TextureInternalFormat::RG_ni16:
+				case TextureInternalFormat::RG_u32:
+				case TextureInternalFormat::RG_i32:
+				case TextureInternalFormat::RG_f32:
+				case TextureInternalFormat::RGBA_u8:
+				case TextureInternalFormat::RGBA_i8:
+				case TextureInternalFormat::RGBA_nu8:
+				case TextureInternalFormat::RGBA_ni8:
+				case TextureInternalFormat::RGBA_u16:
+				case TextureInternalFormat::RGBA_i16:
+				case TextureInternalFormat::RGBA_f16:
+				case TextureInternalFormat::RGBA_nu16:
+				case TextureInternalFormat::RGBA_ni16:
+				case TextureInternalFormat::RGBA_u32:
+				case TextureInternalFormat::RGBA_i32:
+				case TextureInternalFormat::RGBA_f32:
+				case TextureInternalFormat::R_f11_G_f11_B_f10:
+				case TextureInternalFormat::RGB_u10_A_u2:
+				case TextureInternalFormat::RGB_nu10_A_nu2:
+					return true;
+				default:
+					return false;
+			}
+		}
 	}
 }
@@ -479,6 +479,22 @@ namespace spl
 			}
 		}
 
+		constexpr GLenum imageAccessToGLenum(ImageAccess access)
+		{
+			switch (access)
+			{
+				case ImageAccess::ReadOnly:
+					return GL_READ_ONLY;
+				case ImageAccess::WriteOnly:
+					return GL_WRITE_ONLY;
+				case ImageAccess::ReadWrite:
+					return GL_READ_WRITE;
+				default:
+					assert(false);
+					return 0;
+			}
+		}
+
 		
 		constexpr GLenum shaderStageToGLenum(ShaderStage::Stage stage)
 		{
@@ -1047,5 +1063,26 @@ namespace spl
 					return 0;
 			}
 		}
+
+		constexpr GLbitfield memoryBarrierFlagsToGLbitfield(MemoryBarrierFlags::Flags flags)
+		{
+			return (
+					( -((flags & MemoryBarrierFlags::VertexAttribArray)		>> 0) & GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT)
+					| ( -((flags & MemoryBarrierFlags::ElementArray)		>> 1) & GL_ELEMENT_ARRAY_BARRIER_BIT)
+					| ( -((flags & MemoryBarrierFlags::Uniform)				>> 2) & GL_UNIFORM_BARRIER_BIT)
+					| ( -((flags & MemoryBarrierFlags::TextureFetch)		>> 3) & GL_TEXTURE_FETCH_BARRIER_BIT)
+					| ( -((flags & MemoryBarrierFlags::ShaderImageAccess)	>> 4) & GL_SHADER_IMAGE_ACCESS_BARRIER_BIT)
+					| ( -((flags & MemoryBarrierFlags::Command)				>> 5) & GL_COMMAND_BARRIER_BIT)
+					| ( -((flags & MemoryBarrierFlags::PixelBuffer)			>> 6) & GL_PIXEL_BUFFER_BARRIER_BIT)
+					| ( -((flags & MemoryBarrierFlags::TextureUpdate)		>> 7) & GL_TEXTURE_UPDATE_BARRIER_BIT)
+					| ( -((flags & MemoryBarrierFlags::BufferUpdate)		>> 8) & GL_BUFFER_UPDATE_BARRIER_BIT)
+					| ( -((flags & MemoryBarrierFlags::Framebuffer)			>> 9) & GL_FRAMEBUFFER_BARRIER_BIT)
+					| ( -((flags & MemoryBarrierFlags::TransformFeedback)	>> 10) & GL_TRANSFORM_FEEDBACK_BARRIER_BIT)
+					| ( -((flags & MemoryBarrierFlags::AtomicCounter)		>> 11) & GL_ATOMIC_COUNTER_BARRIER_BIT)
+					| ( -((flags & MemoryBarrierFlags::ShaderStorage)		>> 12) & GL_SHADER_STORAGE_BARRIER_BIT)
+					| ( -((flags & MemoryBarrierFlags::ClientMappedBuffer)	>> 13) & GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT)
+					| ( -((flags & MemoryBarrierFlags::QueryBuffer)			>> 14) & GL_QUERY_BUFFER_BARRIER_BIT)
+				);
+		}
 	}
 }
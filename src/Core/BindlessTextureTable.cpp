@@ -0,0 +1,168 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2021-2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <SplayLibrary/Core/Core.hpp>
+#include <SplayLibrary/Private/PrivateNotIncluded.hpp>
+
+namespace spl
+{
+	BindlessTextureTable::BindlessTextureTable() :
+		_elements(),
+		_freeIndices(),
+		_buffer(),
+		_isDirty(false),
+		_firstTextureUnit(0)
+	{
+	}
+
+	uint32_t BindlessTextureTable::add(const Texture& texture, const Sampler* sampler)
+	{
+		uint32_t index;
+		if (_freeIndices.empty())
+		{
+			index = _elements.size();
+			_elements.emplace_back();
+		}
+		else
+		{
+			index = _freeIndices.back();
+			_freeIndices.pop_back();
+		}
+
+		set(index, texture, sampler);
+
+		return index;
+	}
+
+	void BindlessTextureTable::set(uint32_t index, const Texture& texture, const Sampler* sampler)
+	{
+		assert(index < _elements.size());
+		assert(texture.isValid());
+
+		Element& element = _elements[index];
+
+		// Acquire before releasing, so that the handle does not become non-resident if it does not change
+
+		const uint64_t handle = TextureResidency::acquire(texture, sampler);
+		TextureResidency::release(element.handle);
+
+		element.texture = &texture;
+		element.sampler = sampler;
+		element.handle = handle;
+
+		_isDirty = true;
+	}
+
+	void BindlessTextureTable::remove(uint32_t index)
+	{
+		assert(index < _elements.size());
+		assert(_elements[index].texture != nullptr);
+
+		TextureResidency::release(_elements[index].handle);
+		_elements[index] = Element();
+		_freeIndices.push_back(index);
+
+		_isDirty = true;
+	}
+
+	void BindlessTextureTable::clear()
+	{
+		for (const Element& element : _elements)
+		{
+			TextureResidency::release(element.handle);
+		}
+
+		_elements.clear();
+		_freeIndices.clear();
+
+		_isDirty = true;
+	}
+
+	void BindlessTextureTable::bind(uint32_t bindingIndex, uint32_t firstTextureUnit)
+	{
+		const uint32_t count = _elements.size();
+		if (count == 0)
+		{
+			return;
+		}
+
+		if (!isBindless())
+		{
+			const Texture** textures = reinterpret_cast<const Texture**>(alloca(sizeof(const Texture*) * count));
+			const Sampler** samplers = reinterpret_cast<const Sampler**>(alloca(sizeof(const Sampler*) * count));
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				textures[i] = _elements[i].texture;
+				samplers[i] = _elements[i].sampler;
+			}
+
+			Texture::bind(textures, firstTextureUnit, count);
+			Sampler::bind(samplers, firstTextureUnit, count);
+
+			_isDirty = _isDirty || firstTextureUnit != _firstTextureUnit;
+		}
+
+		if (_isDirty)
+		{
+			_upload(firstTextureUnit);
+		}
+
+		const uintptr_t size = count * sizeof(uint64_t);
+		const IndexedBufferBinding& binding = Context::getCurrentContext()->getIndexedBufferBinding(BufferTarget::ShaderStorage, bindingIndex);
+		if (binding.buffer != &_buffer || binding.offset != 0 || binding.size != size)
+		{
+			Buffer::bind(BufferTarget::ShaderStorage, &_buffer, bindingIndex, size, 0);
+		}
+	}
+
+	const Buffer& BindlessTextureTable::getBuffer() const
+	{
+		return _buffer;
+	}
+
+	uint32_t BindlessTextureTable::getSize() const
+	{
+		return _elements.size();
+	}
+
+	bool BindlessTextureTable::isBindless() const
+	{
+		return TextureResidency::isSupported();
+	}
+
+	BindlessTextureTable::~BindlessTextureTable()
+	{
+		clear();
+	}
+
+	void BindlessTextureTable::_upload(uint32_t firstTextureUnit)
+	{
+		const bool bindless = isBindless();
+
+		std::vector<uint64_t> values(_elements.size(), 0);
+		for (uint32_t i = 0; i < _elements.size(); ++i)
+		{
+			if (_elements[i].texture)
+			{
+				values[i] = bindless ? _elements[i].handle : firstTextureUnit + i;
+			}
+		}
+
+		// The buffer grows by powers of two, to be recreated only a few times when elements are added one by one
+
+		const uintptr_t size = values.size() * sizeof(uint64_t);
+		if (!_buffer.isValid() || _buffer.getSize() < size)
+		{
+			_buffer.createNew(std::bit_ceil(size), BufferStorageFlags::DynamicStorage);
+		}
+
+		_buffer.update(values.data(), size, 0);
+
+		_isDirty = false;
+		_firstTextureUnit = firstTextureUnit;
+	}
+}
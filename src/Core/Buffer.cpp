@@ -18,7 +18,10 @@ namespace spl
 		_mapPtr(nullptr),
 		_mapAccess(BufferMapAccessFlags::None),
 		_mapSize(0),
-		_mapOffset(0)
+		_mapOffset(0),
+		_label(),
+		_contextBindings(),
+		_shaderWriteEpoch(0)
 	{
 	}
 
@@ -58,20 +61,31 @@ namespace spl
 	{
 		assert(size != 0);
 
+		Context* context = Context::getCurrentContext();
+
 		if (hasImmutableStorage())
 		{
 			destroy();
 			glCreateBuffers(1, &_buffer);
+
+			if (!_label.empty())
+			{
+				glObjectLabel(GL_BUFFER, _buffer, _label.size(), _label.data());
+			}
 		}
 		else
 		{
-			Context::getCurrentContext()->_unbindBuffer(this);
+			context->_unbindBuffer(this);
+			Context::_addBufferMemory(_usage, _storageFlags, _label, -static_cast<int64_t>(_size));
 		}
 
 		glNamedBufferData(_buffer, size, data, _spl::bufferUsageToGLenum(usage));
 
 		_size = size;
 		_usage = usage;
+		_storageFlags = BufferStorageFlags::None;
+
+		Context::_addBufferMemory(_usage, _storageFlags, _label, _size);
 
 		_mapPtr = nullptr;
 		_mapAccess = BufferMapAccessFlags::None;
@@ -85,21 +99,32 @@ namespace spl
 		assert(!(flags & BufferStorageFlags::MapPersistent) || (flags & BufferStorageFlags::MapRead) || (flags & BufferStorageFlags::MapWrite));
 		assert(!(flags & BufferStorageFlags::MapCoherent) || (flags & BufferStorageFlags::MapPersistent));
 
+		Context* context = Context::getCurrentContext();
+
 		if (hasImmutableStorage())
 		{
 			destroy();
 			glCreateBuffers(1, &_buffer);
+
+			if (!_label.empty())
+			{
+				glObjectLabel(GL_BUFFER, _buffer, _label.size(), _label.data());
+			}
 		}
 		else
 		{
-			Context::getCurrentContext()->_unbindBuffer(this);
+			context->_unbindBuffer(this);
+			Context::_addBufferMemory(_usage, _storageFlags, _label, -static_cast<int64_t>(_size));
 		}
 
 		glNamedBufferStorage(_buffer, size, data, _spl::bufferStorageFlagsToGLbitfield(flags));
 
 		_size = size;
+		_usage = BufferUsage::Undefined;
 		_storageFlags = flags;
 
+		Context::_addBufferMemory(_usage, _storageFlags, _label, _size);
+
 		_mapPtr = nullptr;
 		_mapAccess = BufferMapAccessFlags::None;
 		_mapSize = 0;
@@ -160,23 +185,26 @@ namespace spl
 		buffer._mapSize = 0;
 		buffer._mapOffset = 0;
 
-		Context* context = Context::getCurrentContext();
-		for (uint8_t i = 0; i < context->_state.bufferBindings.size(); ++i)
+		_label = std::move(buffer._label);
+		buffer._label.clear();
+
+		_contextBindings = std::move(buffer._contextBindings);
+		buffer._contextBindings.clear();
+
+		_shaderWriteEpoch = buffer._shaderWriteEpoch;
+		buffer._shaderWriteEpoch = 0;
+
+		// Each binding is in the state of the context it was made in
+
+		for (const auto& [context, target, index] : _contextBindings)
 		{
-			if (context->_state.bufferBindings[i] == &buffer)
+			if (index == -1)
 			{
-				context->_state.bufferBindings[i] = this;
+				context->_state.bufferBindings[ContextState::bufferTargetToIndex(target)] = this;
 			}
-		}
-
-		for (uint8_t i = 0; i < context->_state.indexedBufferBindings.size(); ++i)
-		{
-			for (uint32_t j = 0; j < context->_state.indexedBufferBindings[i].size(); ++j)
+			else
 			{
-				if (context->_state.indexedBufferBindings[i][j].buffer == &buffer)
-				{
-					context->_state.indexedBufferBindings[i][j].buffer = this;
-				}
+				context->_state.indexedBufferBindings[ContextState::indexedBufferTargetToIndex(target)][index].buffer = this;
 			}
 		}
 	}
@@ -192,6 +220,7 @@ namespace spl
 
 		if (_usage != BufferUsage::Undefined || (_storageFlags & BufferStorageFlags::DynamicStorage))
 		{
+			Context::getCurrentContext()->_prepareBufferUpdate(this);
 			glNamedBufferSubData(_buffer, dstOffset, size, data);
 		}
 		else
@@ -212,6 +241,10 @@ namespace spl
 		assert(&data != this || srcOffset + size <= dstOffset || dstOffset + size <= srcOffset);
 		assert(!isMapped() || (_mapAccess & BufferMapAccessFlags::Persistent));
 
+		Context* context = Context::getCurrentContext();
+		context->_requireMemoryBarrier(&data, MemoryBarrierFlags::BufferUpdate);
+		context->_prepareBufferUpdate(this);
+
 		glCopyNamedBufferSubData(data._buffer, _buffer, srcOffset, dstOffset, size);
 	}
 
@@ -230,6 +263,8 @@ namespace spl
 		assert(!(flags & BufferMapAccessFlags::FlushExplicit) || (flags & BufferMapAccessFlags::Write));
 		assert(!(flags & BufferMapAccessFlags::Unsynchronized) || !(flags & BufferMapAccessFlags::Read));
 
+		Context::getCurrentContext()->_prepareBufferUpdate(this);
+
 		if (size == -1)
 		{
 			assert(offset == 0);
@@ -295,11 +330,24 @@ namespace spl
 
 	}
 
+	void Buffer::setLabel(const std::string& label)
+	{
+		if (_buffer != 0)
+		{
+			Context::_moveMemoryLabel(_label, label, _size);
+			glObjectLabel(GL_BUFFER, _buffer, label.size(), label.data());
+		}
+
+		_label = label;
+	}
+
 	void Buffer::destroy()
 	{
 		if (_buffer != 0)
 		{
-			Context::getCurrentContext()->_unbindBuffer(this);
+			Context* context = Context::getCurrentContext();
+			context->_unbindBuffer(this);
+			Context::_addBufferMemory(_usage, _storageFlags, _label, -static_cast<int64_t>(_size));
 
 			glDeleteBuffers(1, &_buffer);
 
@@ -360,6 +408,11 @@ namespace spl
 		return _mapOffset;
 	}
 
+	const std::string& Buffer::getLabel() const
+	{
+		return _label;
+	}
+
 	bool Buffer::isValid() const
 	{
 		return _buffer != 0;
@@ -395,21 +448,21 @@ namespace spl
 				assert(size == -1);
 				assert(offset == 0);
 
-				context->_state.indexedBufferBindings[ContextState::indexedBufferTargetToIndex(target)][index] = IndexedBufferBinding();
+				context->_setIndexedBufferBinding(target, index, IndexedBufferBinding());
 				glBindBufferBase(_spl::bufferTargetToGLenum(target), index, 0);
 			}
 			else if (size == -1)
 			{
 				assert(offset == 0);
 
-				context->_state.indexedBufferBindings[ContextState::indexedBufferTargetToIndex(target)][index] = { buffer, buffer->_size, 0 };
+				context->_setIndexedBufferBinding(target, index, { buffer, buffer->_size, 0 });
 				glBindBufferBase(_spl::bufferTargetToGLenum(target), index, buffer->_buffer);
 			}
 			else
 			{
 				assert(offset + size <= buffer->_size);
 
-				context->_state.indexedBufferBindings[ContextState::indexedBufferTargetToIndex(target)][index] = { buffer, size, offset };
+				context->_setIndexedBufferBinding(target, index, { buffer, size, offset });
 				glBindBufferRange(_spl::bufferTargetToGLenum(target), index, buffer->_buffer, offset, size);
 			}
 		}
@@ -419,7 +472,7 @@ namespace spl
 			assert(size == -1);
 			assert(offset == 0);
 
-			context->_state.bufferBindings[ContextState::bufferTargetToIndex(target)] = buffer;
+			context->_setBufferBinding(target, buffer);
 
 			if (buffer)
 			{
@@ -436,9 +489,9 @@ namespace spl
 	{
 		assert(_spl::isIndexedBufferTarget(target));
 
-		std::vector<IndexedBufferBinding>& contextBuffers = Context::getCurrentContext()->_state.indexedBufferBindings[ContextState::indexedBufferTargetToIndex(target)];
+		Context* context = Context::getCurrentContext();
 
-		assert(firstIndex + count <= contextBuffers.size());
+		assert(firstIndex + count <= context->_state.indexedBufferBindings[ContextState::indexedBufferTargetToIndex(target)].size());
 
 		// If this is just unbinding, shortcut the call
 
@@ -447,6 +500,11 @@ namespace spl
 			assert(sizes == nullptr);
 			assert(offsets == nullptr);
 
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				context->_setIndexedBufferBinding(target, firstIndex + i, IndexedBufferBinding());
+			}
+
 			glBindBuffersBase(_spl::bufferTargetToGLenum(target), firstIndex, count, nullptr);
 
 			return;
@@ -461,7 +519,7 @@ namespace spl
 			{
 				names[i] = 0;
 
-				contextBuffers[j] = IndexedBufferBinding();
+				context->_setIndexedBufferBinding(target, j, IndexedBufferBinding());
 			}
 			else
 			{
@@ -469,11 +527,11 @@ namespace spl
 
 				names[i] = buffers[i]->_buffer;
 
-				contextBuffers[j].buffer = buffers[i];
-				contextBuffers[j].size = (sizes ? buffers[i]->getSize() : sizes[i]);
-				contextBuffers[j].offset = (offsets ? 0 : offsets[i]);
+				const IndexedBufferBinding binding = { buffers[i], (sizes ? sizes[i] : buffers[i]->_size), (offsets ? offsets[i] : 0) };
 
-				assert(contextBuffers[j].offset + contextBuffers[j].size <= buffers[i]->_size);
+				assert(binding.offset + binding.size <= buffers[i]->_size);
+
+				context->_setIndexedBufferBinding(target, j, binding);
 			}
 		}
 
@@ -506,6 +564,8 @@ namespace spl
 		assert(isValid());
 		assert(!isMapped() || (_mapAccess & BufferMapAccessFlags::Persistent));
 
+		Context::getCurrentContext()->_prepareBufferUpdate(this);
+
 		if (size == -1)
 		{
 			assert(offset == 0);
@@ -0,0 +1,306 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2021-2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <SplayLibrary/Core/Core.hpp>
+#include <SplayLibrary/Private/PrivateNotIncluded.hpp>
+
+namespace spl
+{
+	BufferAllocator::BufferAllocator() :
+		_buffer(),
+		_scratch(),
+		_alignment(1),
+		_allocatedSize(0),
+		_allocations(),
+		_freeHandles(),
+		_allocationsByOffset(),
+		_freeBlocks(),
+		_movedHandles()
+	{
+	}
+
+	BufferAllocator::BufferAllocator(uintptr_t size, BufferStorageFlags::Flags flags, uintptr_t alignment) : BufferAllocator()
+	{
+		createNew(size, flags, alignment);
+	}
+
+	void BufferAllocator::createNew(uintptr_t size, BufferStorageFlags::Flags flags, uintptr_t alignment)
+	{
+		assert(size != 0);
+		assert(alignment != 0);
+		assert(size % alignment == 0);
+
+		destroy();
+
+		_buffer.createNew(size, flags);
+		_alignment = alignment;
+
+		_freeBlocks[0] = size;
+	}
+
+	uint32_t BufferAllocator::allocate(uintptr_t size, const void* data)
+	{
+		assert(isValid());
+		assert(size != 0);
+
+		const uintptr_t alignedSize = _alignSize(size);
+
+		// First fit in the free blocks
+
+		auto it = _freeBlocks.begin();
+		while (it != _freeBlocks.end() && it->second < alignedSize)
+		{
+			++it;
+		}
+
+		if (it == _freeBlocks.end())
+		{
+			return -1;
+		}
+
+		const uintptr_t offset = it->first;
+		const uintptr_t remainingSize = it->second - alignedSize;
+
+		_freeBlocks.erase(it);
+		if (remainingSize != 0)
+		{
+			_freeBlocks[offset + alignedSize] = remainingSize;
+		}
+
+		// Register the allocation in the indirection table
+
+		uint32_t handle;
+		if (_freeHandles.empty())
+		{
+			handle = _allocations.size();
+			_allocations.emplace_back();
+		}
+		else
+		{
+			handle = _freeHandles.back();
+			_freeHandles.pop_back();
+		}
+
+		_allocations[handle] = { offset, size, true };
+		_allocationsByOffset[offset] = handle;
+		_allocatedSize += alignedSize;
+
+		if (data)
+		{
+			_buffer.update(data, size, offset);
+		}
+
+		return handle;
+	}
+
+	void BufferAllocator::update(uint32_t handle, const void* data, uintptr_t size, uintptr_t offset)
+	{
+		assert(isAllocated(handle));
+
+		const Allocation& allocation = _allocations[handle];
+		size = size == -1 ? allocation.size : size;
+
+		assert(offset + size <= allocation.size);
+
+		_buffer.update(data, size, allocation.offset + offset);
+	}
+
+	void BufferAllocator::free(uint32_t handle)
+	{
+		assert(isAllocated(handle));
+
+		Allocation& allocation = _allocations[handle];
+		const uintptr_t alignedSize = _alignSize(allocation.size);
+
+		_allocationsByOffset.erase(allocation.offset);
+		_insertFreeBlock(allocation.offset, alignedSize);
+		_allocatedSize -= alignedSize;
+
+		allocation = Allocation();
+		_freeHandles.push_back(handle);
+	}
+
+	uintptr_t BufferAllocator::defragment(uintptr_t maxBytesMoved)
+	{
+		assert(isValid());
+
+		// Slide the allocations following the first free block to the beginning of this block, until the budget is
+		// reached or there is only one free block left, at the end of the buffer.
+
+		_movedHandles.clear();
+
+		if (maxBytesMoved == 0)
+		{
+			return 0;
+		}
+
+		uintptr_t bytesMoved = 0;
+		while (!_freeBlocks.empty())
+		{
+			const auto freeIt = _freeBlocks.begin();
+			const uintptr_t freeOffset = freeIt->first;
+			const uintptr_t freeSize = freeIt->second;
+
+			const auto allocationIt = _allocationsByOffset.find(freeOffset + freeSize);
+			if (allocationIt == _allocationsByOffset.end())
+			{
+				break;
+			}
+
+			const uint32_t handle = allocationIt->second;
+			Allocation& allocation = _allocations[handle];
+			const uintptr_t alignedSize = _alignSize(allocation.size);
+
+			// The first move of a call is always done, otherwise an allocation larger than the budget would block the
+			// compaction forever
+
+			if (bytesMoved != 0 && bytesMoved + allocation.size > maxBytesMoved)
+			{
+				break;
+			}
+
+			// The copies go through Buffer::update, which issues the barrier needed if shaders wrote to the pool. Source
+			// and destination cannot overlap in a copy, the scratch buffer is used if they do.
+
+			if (alignedSize <= freeSize)
+			{
+				_buffer.update(_buffer, allocation.size, freeOffset, allocation.offset);
+			}
+			else
+			{
+				if (!_scratch.isValid() || _scratch.getSize() < allocation.size)
+				{
+					_scratch.createNew(allocation.size, BufferStorageFlags::None);
+				}
+
+				_scratch.update(_buffer, allocation.size, 0, allocation.offset);
+				_buffer.update(_scratch, allocation.size, freeOffset, 0);
+			}
+
+			_freeBlocks.erase(freeIt);
+			_allocationsByOffset.erase(allocationIt);
+
+			allocation.offset = freeOffset;
+			_allocationsByOffset[freeOffset] = handle;
+			_insertFreeBlock(freeOffset + alignedSize, freeSize);
+
+			bytesMoved += allocation.size;
+			_movedHandles.push_back(handle);
+		}
+
+		return bytesMoved;
+	}
+
+	void BufferAllocator::destroy()
+	{
+		_buffer.destroy();
+		_scratch.destroy();
+
+		_alignment = 1;
+		_allocatedSize = 0;
+
+		_allocations.clear();
+		_freeHandles.clear();
+		_allocationsByOffset.clear();
+		_freeBlocks.clear();
+
+		_movedHandles.clear();
+	}
+
+	const Buffer& BufferAllocator::getBuffer() const
+	{
+		return _buffer;
+	}
+
+	uintptr_t BufferAllocator::getAlignment() const
+	{
+		return _alignment;
+	}
+
+	uintptr_t BufferAllocator::getOffset(uint32_t handle) const
+	{
+		assert(isAllocated(handle));
+
+		return _allocations[handle].offset;
+	}
+
+	uintptr_t BufferAllocator::getSize(uint32_t handle) const
+	{
+		assert(isAllocated(handle));
+
+		return _allocations[handle].size;
+	}
+
+	uintptr_t BufferAllocator::getAllocatedSize() const
+	{
+		return _allocatedSize;
+	}
+
+	uintptr_t BufferAllocator::getLargestFreeBlockSize() const
+	{
+		uintptr_t largestSize = 0;
+		for (const std::pair<const uintptr_t, uintptr_t>& block : _freeBlocks)
+		{
+			largestSize = std::max(largestSize, block.second);
+		}
+
+		return largestSize;
+	}
+
+	uint32_t BufferAllocator::getFreeBlockCount() const
+	{
+		return _freeBlocks.size();
+	}
+
+	const std::vector<uint32_t>& BufferAllocator::getMovedHandles() const
+	{
+		return _movedHandles;
+	}
+
+	bool BufferAllocator::isValid() const
+	{
+		return _buffer.isValid();
+	}
+
+	bool BufferAllocator::isAllocated(uint32_t handle) const
+	{
+		return handle < _allocations.size() && _allocations[handle].allocated;
+	}
+
+	BufferAllocator::~BufferAllocator()
+	{
+		destroy();
+	}
+
+	uintptr_t BufferAllocator::_alignSize(uintptr_t size) const
+	{
+		return ((size + _alignment - 1) / _alignment) * _alignment;
+	}
+
+	void BufferAllocator::_insertFreeBlock(uintptr_t offset, uintptr_t size)
+	{
+		auto next = _freeBlocks.lower_bound(offset);
+
+		if (next != _freeBlocks.end() && offset + size == next->first)
+		{
+			size += next->second;
+			next = _freeBlocks.erase(next);
+		}
+
+		if (next != _freeBlocks.begin())
+		{
+			const auto previous = std::prev(next);
+			if (previous->first + previous->second == offset)
+			{
+				previous->second += size;
+				return;
+			}
+		}
+
+		_freeBlocks[offset] = size;
+	}
+}
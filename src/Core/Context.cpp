@@ -135,6 +135,26 @@ namespace spl
 
 			stackDebugMessage(message, context);
 		}
+
+		void updateMemoryUsage(MemoryUsage& usage, int64_t bytes)
+		{
+			assert(bytes >= 0 || usage.bytes >= static_cast<uint64_t>(-bytes));
+
+			usage.bytes += bytes;
+			usage.highWaterMark = std::max(usage.highWaterMark, usage.bytes);
+		}
+
+		void updateLabelMemoryUsage(std::unordered_map<std::string, MemoryUsage>& labels, const std::string& label, int64_t bytes)
+		{
+			// Labels are only listed while some memory uses them
+
+			const std::unordered_map<std::string, MemoryUsage>::iterator it = labels.try_emplace(label).first;
+			updateMemoryUsage(it->second, bytes);
+			if (it->second.bytes == 0)
+			{
+				labels.erase(it);
+			}
+		}
 	}
 
 	static void stackDebugMessage(DebugMessage* message, Context* context)
@@ -147,12 +167,19 @@ namespace spl
 	std::unordered_set<Context*> Context::_contexts;
 	std::unordered_map<std::thread::id, Context*> Context::_currentContexts;
 
+	std::mutex Context::_memoryMutex;
+	MemoryStatistics Context::_memoryStatistics;
+
 	Context::Context() :
 		_implementationDependentValues(),
 		_debugContext(false),
 		_debugMessages(),
 		_lastDebugMessageSent(nullptr),
 		_state(),
+		_shaderWriteEpoch(0),
+		_memoryBarrierEpochs(),
+		_requiredMemoryBarriers(MemoryBarrierFlags::None),
+		_writableBindingCount(0),
 		_window(nullptr),
 		_hasBeenActivated(false)
 	{
@@ -200,6 +227,7 @@ namespace spl
 		assert(state.indexedBufferBindings[3].size() == _state.indexedBufferBindings[3].size());
 		assert(state.textureBindings.size() == _state.textureBindings.size());
 		assert(state.samplerBindings.size() == _state.samplerBindings.size());
+		assert(state.imageBindings.size() == _state.imageBindings.size());
 
 		setIsSeamlessCubeMapFilteringEnabled(state.isSeamlessCubeMapFilteringEnabled);
 		setViewport(state.viewport.x, state.viewport.y, state.viewport.z, state.viewport.w);
@@ -245,7 +273,7 @@ namespace spl
 				offsets[j] = state.indexedBufferBindings[i][j].offset;
 			}
 
-			Buffer::bind(ContextState::indexToIndexedBufferTarget(i), buffers.data(), count, 0, sizes.data(), offsets.data());
+			Buffer::bind(ContextState::indexToIndexedBufferTarget(i), buffers.data(), 0, count, sizes.data(), offsets.data());
 		}
 
 		for (uint32_t i = 0; i < _state.textureBindings.size(); ++i)
@@ -261,6 +289,15 @@ namespace spl
 			}
 		}
 
+		for (uint32_t i = 0; i < _state.imageBindings.size(); ++i)
+		{
+			const ImageUnitBinding& binding = state.imageBindings[i];
+			if (_state.imageBindings[i] != binding)
+			{
+				Texture::bindImage(binding.texture, i, binding.access, binding.format, binding.level, binding.isLayered ? -1 : binding.layer);
+			}
+		}
+
 		for (uint8_t i = 0; i < _state.framebufferBindings.size(); ++i)
 		{
 			if (_state.framebufferBindings[i] != state.framebufferBindings[i])
@@ -269,6 +306,11 @@ namespace spl
 			}
 		}
 
+		if (_state.shaderPipelineBinding != state.shaderPipelineBinding)
+		{
+			ShaderPipeline::bind(state.shaderPipelineBinding);
+		}
+
 		if (_state.shaderBinding != state.shaderBinding)
 		{
 			ShaderProgram::bind(state.shaderBinding);
@@ -582,6 +624,19 @@ namespace spl
 		}
 	}
 
+	const ImageUnitBinding& Context::getImageBinding(uint32_t imageUnit) const
+	{
+		if (imageUnit < _state.imageBindings.size())
+		{
+			return _state.imageBindings[imageUnit];
+		}
+		else
+		{
+			static constexpr ImageUnitBinding noBinding = {};
+			return noBinding;
+		}
+	}
+
 	const Framebuffer* Context::getFramebufferBinding(FramebufferTarget target) const
 	{
 		return _state.framebufferBindings[ContextState::framebufferTargetToIndex(target)];
@@ -592,11 +647,87 @@ namespace spl
 		return _state.shaderBinding;
 	}
 
+	const ShaderPipeline* Context::getShaderPipelineBinding() const
+	{
+		return _state.shaderPipelineBinding;
+	}
+
 	const ContextState& Context::getState() const
 	{
 		return _state;
 	}
 
+	MemoryStatistics Context::getMemoryStatistics()
+	{
+		std::lock_guard lock(_memoryMutex);
+
+		return _memoryStatistics;
+	}
+
+	void Context::resetMemoryHighWaterMarks()
+	{
+		std::lock_guard lock(_memoryMutex);
+
+		_memoryStatistics.total.highWaterMark = _memoryStatistics.total.bytes;
+		_memoryStatistics.buffers.highWaterMark = _memoryStatistics.buffers.bytes;
+		_memoryStatistics.textures.highWaterMark = _memoryStatistics.textures.bytes;
+		_memoryStatistics.renderbuffers.highWaterMark = _memoryStatistics.renderbuffers.bytes;
+
+		for (MemoryUsage& usage : _memoryStatistics.buffersByUsage)
+		{
+			usage.highWaterMark = usage.bytes;
+		}
+
+		for (std::pair<const uint32_t, MemoryUsage>& x : _memoryStatistics.buffersByStorageFlags)
+		{
+			x.second.highWaterMark = x.second.bytes;
+		}
+
+		for (std::pair<const std::string, MemoryUsage>& x : _memoryStatistics.labels)
+		{
+			x.second.highWaterMark = x.second.bytes;
+		}
+	}
+
+	bool Context::getIsParallelShaderCompileSupported() const
+	{
+		return GLAD_GL_KHR_parallel_shader_compile || GLAD_GL_ARB_parallel_shader_compile;
+	}
+
+	void Context::setMaxShaderCompilerThreads(uint32_t count)
+	{
+		// 0 disables parallel compilation, 0xFFFFFFFF lets the driver choose
+
+		if (GLAD_GL_KHR_parallel_shader_compile)
+		{
+			glMaxShaderCompilerThreadsKHR(count);
+		}
+		else if (GLAD_GL_ARB_parallel_shader_compile)
+		{
+			glMaxShaderCompilerThreadsARB(count);
+		}
+	}
+
+	void Context::memoryBarrier(MemoryBarrierFlags::Flags flags)
+	{
+		if (flags == MemoryBarrierFlags::None)
+		{
+			return;
+		}
+
+		glMemoryBarrier(_spl::memoryBarrierFlagsToGLbitfield(flags));
+
+		// Every shader write recorded so far is now visible to the operations covered by the flags
+
+		for (uint8_t i = 0; i < _memoryBarrierEpochs.size(); ++i)
+		{
+			if (flags & (1 << i))
+			{
+				_memoryBarrierEpochs[i] = _shaderWriteEpoch;
+			}
+		}
+	}
+
 	Window* Context::getWindow()
 	{
 		return _window;
@@ -724,6 +855,11 @@ namespace spl
 
 	bool Context::_destroyContext(Context* context)
 	{
+		// Done before locking, since the program cache may query the current context while it holds its own lock
+
+		ProgramCache::_dropContext(context);
+		context->_dropBindings();
+
 		_mutex.lock();
 
 		auto it = _contexts.find(context);
@@ -790,6 +926,7 @@ namespace spl
 		_state.indexedBufferBindings[3].resize(_implementationDependentValues.shader.maxUniformBufferBindings, IndexedBufferBinding());
 		_state.textureBindings.resize(_implementationDependentValues.shader.maxCombinedTextureImageUnits);
 		_state.samplerBindings.resize(_implementationDependentValues.shader.maxCombinedTextureImageUnits);
+		_state.imageBindings.resize(_implementationDependentValues.shader.maxImageUnits);
 	}
 
 	namespace
@@ -1056,46 +1193,271 @@ namespace spl
 		loadValue(GL_MAX_TRANSFORM_FEEDBACK_BUFFERS,					&transformFeedback.maxTransformFeedbackBuffers);
 	}
 
-	void Context::_unbindBuffer(const Buffer* buffer)
+	void Context::_setBufferBinding(BufferTarget target, const Buffer* buffer)
 	{
-		for (uint8_t i = 0; i < _state.bufferBindings.size(); ++i)
+		const Buffer*& slot = _state.bufferBindings[ContextState::bufferTargetToIndex(target)];
+
+		if (slot != buffer)
+		{
+			if (slot)
+			{
+				std::vector<std::tuple<Context*, BufferTarget, uint32_t>>& slots = slot->_contextBindings;
+				const std::vector<std::tuple<Context*, BufferTarget, uint32_t>>::iterator it = std::find(slots.begin(), slots.end(), std::tuple<Context*, BufferTarget, uint32_t>(this, target, -1));
+				assert(it != slots.end());
+				*it = slots.back();
+				slots.pop_back();
+			}
+
+			if (buffer)
+			{
+				buffer->_contextBindings.emplace_back(this, target, -1);
+			}
+
+			slot = buffer;
+		}
+	}
+
+	void Context::_setIndexedBufferBinding(BufferTarget target, uint32_t index, const IndexedBufferBinding& binding)
+	{
+		IndexedBufferBinding& slot = _state.indexedBufferBindings[ContextState::indexedBufferTargetToIndex(target)][index];
+
+		if (slot.buffer != binding.buffer)
+		{
+			if (target == BufferTarget::ShaderStorage || target == BufferTarget::AtomicCounter)
+			{
+				_writableBindingCount += (binding.buffer != nullptr) - (slot.buffer != nullptr);
+			}
+
+			if (slot.buffer)
+			{
+				std::vector<std::tuple<Context*, BufferTarget, uint32_t>>& slots = slot.buffer->_contextBindings;
+				const std::vector<std::tuple<Context*, BufferTarget, uint32_t>>::iterator it = std::find(slots.begin(), slots.end(), std::tuple<Context*, BufferTarget, uint32_t>(this, target, index));
+				assert(it != slots.end());
+				*it = slots.back();
+				slots.pop_back();
+			}
+
+			if (binding.buffer)
+			{
+				binding.buffer->_contextBindings.emplace_back(this, target, index);
+			}
+		}
+
+		slot = binding;
+	}
+
+	void Context::_setTextureBinding(uint32_t textureUnit, const Texture* texture)
+	{
+		const Texture*& slot = _state.textureBindings[textureUnit];
+
+		if (slot != texture)
+		{
+			if (slot)
+			{
+				std::vector<std::pair<Context*, uint32_t>>& units = slot->_contextBindings;
+				const std::vector<std::pair<Context*, uint32_t>>::iterator it = std::find(units.begin(), units.end(), std::pair<Context*, uint32_t>(this, textureUnit));
+				assert(it != units.end());
+				*it = units.back();
+				units.pop_back();
+			}
+
+			if (texture)
+			{
+				texture->_contextBindings.emplace_back(this, textureUnit);
+			}
+
+			slot = texture;
+		}
+	}
+
+	void Context::_setImageBinding(uint32_t imageUnit, const ImageUnitBinding& binding)
+	{
+		ImageUnitBinding& slot = _state.imageBindings[imageUnit];
+
+		const bool wasWritable = slot.texture && slot.access != ImageAccess::ReadOnly;
+		const bool isWritable = binding.texture && binding.access != ImageAccess::ReadOnly;
+		_writableBindingCount += isWritable - wasWritable;
+
+		if (slot.texture != binding.texture)
+		{
+			if (slot.texture)
+			{
+				std::vector<std::pair<Context*, uint32_t>>& units = slot.texture->_contextImageBindings;
+				const std::vector<std::pair<Context*, uint32_t>>::iterator it = std::find(units.begin(), units.end(), std::pair<Context*, uint32_t>(this, imageUnit));
+				assert(it != units.end());
+				*it = units.back();
+				units.pop_back();
+			}
+
+			if (binding.texture)
+			{
+				binding.texture->_contextImageBindings.emplace_back(this, imageUnit);
+			}
+		}
+
+		slot = binding;
+	}
+
+	void Context::_setSamplerBinding(uint32_t textureUnit, const Sampler* sampler)
+	{
+		const Sampler*& slot = _state.samplerBindings[textureUnit];
+
+		if (slot != sampler)
 		{
-			if (_state.bufferBindings[i] == buffer)
+			if (slot)
 			{
-				Buffer::bind(ContextState::indexToBufferTarget(i), nullptr);
+				std::vector<std::pair<Context*, uint32_t>>& units = slot->_contextBindings;
+				const std::vector<std::pair<Context*, uint32_t>>::iterator it = std::find(units.begin(), units.end(), std::pair<Context*, uint32_t>(this, textureUnit));
+				assert(it != units.end());
+				*it = units.back();
+				units.pop_back();
 			}
+
+			if (sampler)
+			{
+				sampler->_contextBindings.emplace_back(this, textureUnit);
+			}
+
+			slot = sampler;
+		}
+	}
+
+	void Context::_dropBindings()
+	{
+		// Removes the entries of this context from the resources still bound to it
+
+		for (uint8_t i = 0; i < _state.bufferBindings.size(); ++i)
+		{
+			_setBufferBinding(ContextState::indexToBufferTarget(i), nullptr);
 		}
 
 		for (uint8_t i = 0; i < _state.indexedBufferBindings.size(); ++i)
 		{
 			for (uint32_t j = 0; j < _state.indexedBufferBindings[i].size(); ++j)
 			{
-				if (_state.indexedBufferBindings[i][j].buffer == buffer)
-				{
-					Buffer::bind(ContextState::indexToIndexedBufferTarget(i), nullptr, j);
-				}
+				_setIndexedBufferBinding(ContextState::indexToIndexedBufferTarget(i), j, {});
+			}
+		}
+
+		for (uint32_t i = 0; i < _state.textureBindings.size(); ++i)
+		{
+			_setTextureBinding(i, nullptr);
+		}
+
+		for (uint32_t i = 0; i < _state.samplerBindings.size(); ++i)
+		{
+			_setSamplerBinding(i, nullptr);
+		}
+
+		for (uint32_t i = 0; i < _state.imageBindings.size(); ++i)
+		{
+			_setImageBinding(i, {});
+		}
+	}
+
+	void Context::_addBufferMemory(BufferUsage usage, BufferStorageFlags::Flags flags, const std::string& label, int64_t bytes)
+	{
+		std::lock_guard lock(_memoryMutex);
+
+		updateMemoryUsage(_memoryStatistics.total, bytes);
+		updateMemoryUsage(_memoryStatistics.buffers, bytes);
+		updateMemoryUsage(_memoryStatistics.buffersByUsage[static_cast<uint32_t>(usage)], bytes);
+		if (usage == BufferUsage::Undefined)
+		{
+			updateMemoryUsage(_memoryStatistics.buffersByStorageFlags[flags], bytes);
+		}
+		updateLabelMemoryUsage(_memoryStatistics.labels, label, bytes);
+	}
+
+	void Context::_addTextureMemory(const std::string& label, int64_t bytes)
+	{
+		std::lock_guard lock(_memoryMutex);
+
+		updateMemoryUsage(_memoryStatistics.total, bytes);
+		updateMemoryUsage(_memoryStatistics.textures, bytes);
+		updateLabelMemoryUsage(_memoryStatistics.labels, label, bytes);
+	}
+
+	void Context::_addRenderbufferMemory(const std::string& label, int64_t bytes)
+	{
+		std::lock_guard lock(_memoryMutex);
+
+		updateMemoryUsage(_memoryStatistics.total, bytes);
+		updateMemoryUsage(_memoryStatistics.renderbuffers, bytes);
+		updateLabelMemoryUsage(_memoryStatistics.labels, label, bytes);
+	}
+
+	void Context::_moveMemoryLabel(const std::string& oldLabel, const std::string& newLabel, uint64_t bytes)
+	{
+		std::lock_guard lock(_memoryMutex);
+
+		updateLabelMemoryUsage(_memoryStatistics.labels, newLabel, bytes);
+		updateLabelMemoryUsage(_memoryStatistics.labels, oldLabel, -static_cast<int64_t>(bytes));
+	}
+
+	void Context::_unbindBuffer(const Buffer* buffer)
+	{
+		// Bindings in other contexts are only removed from their state, they cannot be changed from this one
+
+		while (!buffer->_contextBindings.empty())
+		{
+			const auto [context, target, index] = buffer->_contextBindings.back();
+			if (context == this)
+			{
+				Buffer::bind(target, nullptr, index);
+			}
+			else if (index == -1)
+			{
+				context->_setBufferBinding(target, nullptr);
+			}
+			else
+			{
+				context->_setIndexedBufferBinding(target, index, {});
 			}
 		}
 	}
 
 	void Context::_unbindTexture(const Texture* texture)
 	{
-		for (uint32_t i = 0; i < _state.textureBindings.size(); ++i)
+		while (!texture->_contextBindings.empty())
+		{
+			const auto [context, textureUnit] = texture->_contextBindings.back();
+			if (context == this)
+			{
+				Texture::bind(nullptr, textureUnit);
+			}
+			else
+			{
+				context->_setTextureBinding(textureUnit, nullptr);
+			}
+		}
+
+		while (!texture->_contextImageBindings.empty())
 		{
-			if (_state.textureBindings[i] == texture)
+			const auto [context, imageUnit] = texture->_contextImageBindings.back();
+			if (context == this)
 			{
-				Texture::bind(nullptr, i);
+				Texture::bindImage(nullptr, imageUnit, ImageAccess::ReadOnly);
+			}
+			else
+			{
+				context->_setImageBinding(imageUnit, {});
 			}
 		}
 	}
 
 	void Context::_unbindSampler(const Sampler* sampler)
 	{
-		for (uint32_t i = 0; i < _state.samplerBindings.size(); ++i)
+		while (!sampler->_contextBindings.empty())
 		{
-			if (_state.samplerBindings[i] == sampler)
+			const auto [context, textureUnit] = sampler->_contextBindings.back();
+			if (context == this)
+			{
+				Sampler::bind(nullptr, textureUnit);
+			}
+			else
 			{
-				Sampler::bind(nullptr, i);
+				context->_setSamplerBinding(textureUnit, nullptr);
 			}
 		}
 	}
@@ -1118,4 +1480,139 @@ namespace spl
 			ShaderProgram::bind(nullptr);
 		}
 	}
+
+	void Context::_unbindShaderPipeline(const ShaderPipeline* pipeline)
+	{
+		if (_state.shaderPipelineBinding == pipeline)
+		{
+			ShaderPipeline::bind(nullptr);
+		}
+	}
+
+	void Context::_prepareShaderInvocation(const VertexArray* vertexArray, bool isIndexed, const Buffer* indirectBuffer, const Buffer* parameterBuffer)
+	{
+		// Nothing to look for if every shader write is already visible to the sources of a draw or a dispatch
+
+		if (!_isMemoryBarrierPending(MemoryBarrierFlags::VertexAttribArray)
+			&& !_isMemoryBarrierPending(MemoryBarrierFlags::ElementArray)
+			&& !_isMemoryBarrierPending(MemoryBarrierFlags::Command)
+			&& !_isMemoryBarrierPending(MemoryBarrierFlags::Uniform)
+			&& !_isMemoryBarrierPending(MemoryBarrierFlags::TextureFetch))
+		{
+			return;
+		}
+
+		if (vertexArray)
+		{
+			for (const Buffer* buffer : vertexArray->_arrayBuffers)
+			{
+				_requireMemoryBarrier(buffer, MemoryBarrierFlags::VertexAttribArray);
+			}
+
+			if (isIndexed)
+			{
+				_requireMemoryBarrier(vertexArray->_elementBuffer, MemoryBarrierFlags::ElementArray);
+			}
+		}
+
+		_requireMemoryBarrier(indirectBuffer, MemoryBarrierFlags::Command);
+		_requireMemoryBarrier(parameterBuffer, MemoryBarrierFlags::Command);
+
+		for (const IndexedBufferBinding& binding : _state.indexedBufferBindings[ContextState::indexedBufferTargetToIndex(BufferTarget::Uniform)])
+		{
+			_requireMemoryBarrier(binding.buffer, MemoryBarrierFlags::Uniform);
+		}
+
+		for (const Texture* texture : _state.textureBindings)
+		{
+			_requireMemoryBarrier(texture, MemoryBarrierFlags::TextureFetch);
+		}
+
+		_issueRequiredMemoryBarriers();
+	}
+
+	void Context::_prepareBufferUpdate(const Buffer* buffer)
+	{
+		_requireMemoryBarrier(buffer, MemoryBarrierFlags::BufferUpdate);
+		_issueRequiredMemoryBarriers();
+	}
+
+	void Context::_prepareTextureUpdate(const Texture* texture, const Buffer* pixelBuffer)
+	{
+		_requireMemoryBarrier(texture, MemoryBarrierFlags::TextureUpdate);
+		_requireMemoryBarrier(pixelBuffer, MemoryBarrierFlags::PixelBuffer);
+		_issueRequiredMemoryBarriers();
+	}
+
+	void Context::_recordShaderWrites()
+	{
+		if (_writableBindingCount == 0)
+		{
+			return;
+		}
+
+		++_shaderWriteEpoch;
+
+		for (const IndexedBufferBinding& binding : _state.indexedBufferBindings[ContextState::indexedBufferTargetToIndex(BufferTarget::ShaderStorage)])
+		{
+			if (binding.buffer)
+			{
+				binding.buffer->_shaderWriteEpoch = _shaderWriteEpoch;
+			}
+		}
+
+		for (const IndexedBufferBinding& binding : _state.indexedBufferBindings[ContextState::indexedBufferTargetToIndex(BufferTarget::AtomicCounter)])
+		{
+			if (binding.buffer)
+			{
+				binding.buffer->_shaderWriteEpoch = _shaderWriteEpoch;
+			}
+		}
+
+		for (const ImageUnitBinding& binding : _state.imageBindings)
+		{
+			if (binding.texture && binding.access != ImageAccess::ReadOnly)
+			{
+				binding.texture->_shaderWriteEpoch = _shaderWriteEpoch;
+				if (binding.texture->_params.target == TextureTarget::Buffer)
+				{
+					binding.texture->_params.buffer->_shaderWriteEpoch = _shaderWriteEpoch;
+				}
+			}
+		}
+	}
+
+	bool Context::_isMemoryBarrierPending(MemoryBarrierFlags::Flags flag) const
+	{
+		return _memoryBarrierEpochs[std::countr_zero(static_cast<uint32_t>(flag))] < _shaderWriteEpoch;
+	}
+
+	void Context::_requireMemoryBarrier(const Buffer* buffer, MemoryBarrierFlags::Flags flag)
+	{
+		if (buffer && buffer->_shaderWriteEpoch > _memoryBarrierEpochs[std::countr_zero(static_cast<uint32_t>(flag))])
+		{
+			_requiredMemoryBarriers = static_cast<MemoryBarrierFlags::Flags>(_requiredMemoryBarriers | flag);
+		}
+	}
+
+	void Context::_requireMemoryBarrier(const Texture* texture, MemoryBarrierFlags::Flags flag)
+	{
+		if (texture)
+		{
+			if (texture->_shaderWriteEpoch > _memoryBarrierEpochs[std::countr_zero(static_cast<uint32_t>(flag))])
+			{
+				_requiredMemoryBarriers = static_cast<MemoryBarrierFlags::Flags>(_requiredMemoryBarriers | flag);
+			}
+			else if (texture->_params.target == TextureTarget::Buffer)
+			{
+				_requireMemoryBarrier(texture->_params.buffer, flag);
+			}
+		}
+	}
+
+	void Context::_issueRequiredMemoryBarriers()
+	{
+		memoryBarrier(_requiredMemoryBarriers);
+		_requiredMemoryBarriers = MemoryBarrierFlags::None;
+	}
 }
@@ -0,0 +1,197 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2021-2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <SplayLibrary/Core/Core.hpp>
+#include <SplayLibrary/Private/PrivateNotIncluded.hpp>
+
+namespace spl
+{
+	DrawCommandBuffer::DrawCommandBuffer() :
+		_buffer(),
+		_capacity(0),
+		_frameCount(0),
+		_currentRegion(0),
+		_commandCount(0),
+		_commandType(CommandType::Undefined),
+		_fences()
+	{
+	}
+
+	DrawCommandBuffer::DrawCommandBuffer(uint32_t capacity, uint32_t frameCount) : DrawCommandBuffer()
+	{
+		createNew(capacity, frameCount);
+	}
+
+	void DrawCommandBuffer::createNew(uint32_t capacity, uint32_t frameCount)
+	{
+		assert(capacity != 0);
+		assert(frameCount != 0);
+
+		destroy();
+
+		// The mapping is coherent: commands written before a draw are visible to it without any flush
+
+		constexpr BufferStorageFlags::Flags storageFlags = static_cast<BufferStorageFlags::Flags>(BufferStorageFlags::MapWrite | BufferStorageFlags::MapPersistent | BufferStorageFlags::MapCoherent);
+		constexpr BufferMapAccessFlags::Flags mapFlags = static_cast<BufferMapAccessFlags::Flags>(BufferMapAccessFlags::Write | BufferMapAccessFlags::Persistent | BufferMapAccessFlags::Coherent);
+
+		_buffer.createNew(static_cast<uintptr_t>(capacity) * _stride * frameCount, storageFlags);
+		_buffer.map(mapFlags);
+
+		_capacity = capacity;
+		_frameCount = frameCount;
+		_currentRegion = frameCount - 1;
+		_fences.resize(frameCount, nullptr);
+	}
+
+	void DrawCommandBuffer::destroy()
+	{
+		for (void* fence : _fences)
+		{
+			if (fence)
+			{
+				glDeleteSync(reinterpret_cast<GLsync>(fence));
+			}
+		}
+
+		_buffer.destroy();
+		_capacity = 0;
+		_frameCount = 0;
+
+		_currentRegion = 0;
+		_commandCount = 0;
+		_commandType = CommandType::Undefined;
+
+		_fences.clear();
+	}
+
+	void DrawCommandBuffer::begin()
+	{
+		assert(isValid());
+
+		_currentRegion = (_currentRegion + 1) % _frameCount;
+		_commandCount = 0;
+		_commandType = CommandType::Undefined;
+
+		// The region must not be overwritten while draws submitted "frameCount" frames ago may still read it
+
+		GLsync fence = reinterpret_cast<GLsync>(_fences[_currentRegion]);
+		if (fence)
+		{
+			GLenum status = glClientWaitSync(fence, 0, 0);
+			while (status == GL_TIMEOUT_EXPIRED)
+			{
+				status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+			}
+
+			glDeleteSync(fence);
+			_fences[_currentRegion] = nullptr;
+		}
+	}
+
+	uint32_t DrawCommandBuffer::push(const DrawArraysCommand& command)
+	{
+		*reinterpret_cast<DrawArraysCommand*>(_reserve(CommandType::Arrays)) = command;
+
+		return _commandCount - 1;
+	}
+
+	uint32_t DrawCommandBuffer::push(const DrawElementsCommand& command)
+	{
+		*reinterpret_cast<DrawElementsCommand*>(_reserve(CommandType::Elements)) = command;
+
+		return _commandCount - 1;
+	}
+
+	void DrawCommandBuffer::draw(const VertexArray& vertexArray, PrimitiveType primitiveType)
+	{
+		assert(isValid());
+		assert(_commandType != CommandType::Elements);
+
+		if (_commandCount == 0)
+		{
+			return;
+		}
+
+		vertexArray.multiDrawArraysIndirect(primitiveType, _buffer, _commandCount, getOffset(), _stride);
+		_fenceRegion();
+	}
+
+	void DrawCommandBuffer::draw(const VertexArray& vertexArray, PrimitiveType primitiveType, IndexType indexType)
+	{
+		assert(isValid());
+		assert(_commandType != CommandType::Arrays);
+
+		if (_commandCount == 0)
+		{
+			return;
+		}
+
+		vertexArray.multiDrawElementsIndirect(primitiveType, indexType, _buffer, _commandCount, getOffset(), _stride);
+		_fenceRegion();
+	}
+
+	const Buffer& DrawCommandBuffer::getBuffer() const
+	{
+		return _buffer;
+	}
+
+	uintptr_t DrawCommandBuffer::getOffset() const
+	{
+		return static_cast<uintptr_t>(_currentRegion) * _capacity * _stride;
+	}
+
+	uint32_t DrawCommandBuffer::getStride() const
+	{
+		return _stride;
+	}
+
+	uint32_t DrawCommandBuffer::getCommandCount() const
+	{
+		return _commandCount;
+	}
+
+	uint32_t DrawCommandBuffer::getCapacity() const
+	{
+		return _capacity;
+	}
+
+	bool DrawCommandBuffer::isValid() const
+	{
+		return _buffer.isValid();
+	}
+
+	DrawCommandBuffer::~DrawCommandBuffer()
+	{
+		destroy();
+	}
+
+	void* DrawCommandBuffer::_reserve(CommandType type)
+	{
+		assert(isValid());
+		assert(_commandCount < _capacity);
+		assert(_commandType == CommandType::Undefined || _commandType == type);
+
+		_commandType = type;
+
+		uint8_t* ptr = reinterpret_cast<uint8_t*>(_buffer.getMapPointer()) + getOffset() + static_cast<uintptr_t>(_commandCount) * _stride;
+		++_commandCount;
+
+		return ptr;
+	}
+
+	void DrawCommandBuffer::_fenceRegion()
+	{
+		// Only the last draw reading the region needs to be waited for
+
+		if (_fences[_currentRegion])
+		{
+			glDeleteSync(reinterpret_cast<GLsync>(_fences[_currentRegion]));
+		}
+
+		_fences[_currentRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	}
+}
@@ -0,0 +1,235 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2021-2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <SplayLibrary/Core/Core.hpp>
+#include <SplayLibrary/Private/PrivateNotIncluded.hpp>
+
+namespace spl
+{
+	namespace
+	{
+		static_assert(sizeof(CullingInstance) == 32);
+		static_assert(sizeof(DrawElementsCommand) == 20);
+
+		constexpr char cullingShaderSource[] = R"glsl(
+			#version 460 core
+
+			layout(local_size_x = 64) in;
+
+			struct Instance
+			{
+				vec4 sphere;
+				uint meshIndex;
+			};
+
+			struct DrawCommand
+			{
+				uint count;
+				uint instanceCount;
+				uint firstIndex;
+				int baseVertex;
+				uint baseInstance;
+			};
+
+			layout(std430, binding = 0) readonly buffer Instances { Instance instances[]; };
+			layout(std430, binding = 1) readonly buffer Meshes { DrawCommand meshes[]; };
+			layout(std430, binding = 2) writeonly buffer Commands { DrawCommand commands[]; };
+			layout(std430, binding = 3) buffer DrawCount { uint drawCount; };
+
+			uniform mat4 viewProjection;
+			uniform uint instanceCount;
+
+			void main()
+			{
+				const uint instanceIndex = gl_GlobalInvocationID.x;
+				if (instanceIndex >= instanceCount)
+				{
+					return;
+				}
+
+				const Instance instance = instances[instanceIndex];
+
+				// Planes of the clip volume (-w <= x, y, z <= w), from the rows of the matrix
+
+				const mat4 rows = transpose(viewProjection);
+				for (int i = 0; i < 3; ++i)
+				{
+					for (int j = 0; j < 2; ++j)
+					{
+						const vec4 plane = (j == 0) ? rows[3] + rows[i] : rows[3] - rows[i];
+						if (dot(plane.xyz, instance.sphere.xyz) + plane.w < -instance.sphere.w * length(plane.xyz))
+						{
+							return;
+						}
+					}
+				}
+
+				DrawCommand command = meshes[instance.meshIndex];
+				command.instanceCount = 1;
+				command.baseInstance = instanceIndex;
+
+				commands[atomicAdd(drawCount, 1)] = command;
+			}
+		)glsl";
+	}
+
+	FrustumCuller::FrustumCuller() :
+		_program(),
+		_instanceBuffer(),
+		_meshBuffer(),
+		_commandBuffer(),
+		_countBuffer(),
+		_instanceCount(0),
+		_instanceCapacity(0)
+	{
+	}
+
+	FrustumCuller::FrustumCuller(uint32_t instanceCapacity, uint32_t meshCapacity) : FrustumCuller()
+	{
+		createNew(instanceCapacity, meshCapacity);
+	}
+
+	bool FrustumCuller::createNew(uint32_t instanceCapacity, uint32_t meshCapacity)
+	{
+		assert(instanceCapacity != 0);
+		assert(meshCapacity != 0);
+
+		destroy();
+
+		// The program is shared by all the cullers of the context
+
+		ShaderModule module;
+		if (!module.createFromGlsl(ShaderStage::Compute, cullingShaderSource, sizeof(cullingShaderSource) - 1))
+		{
+			return false;
+		}
+
+		const ShaderModule* moduleArray[] = { &module };
+		_program = ProgramCache::getProgram(moduleArray, 1);
+		if (!_program)
+		{
+			return false;
+		}
+
+		_instanceBuffer.createNew(instanceCapacity * sizeof(CullingInstance), BufferStorageFlags::DynamicStorage);
+		_meshBuffer.createNew(meshCapacity * sizeof(DrawElementsCommand), BufferStorageFlags::DynamicStorage);
+		_commandBuffer.createNew(instanceCapacity * sizeof(DrawElementsCommand), BufferStorageFlags::None);
+		_countBuffer.createNew(sizeof(uint32_t), BufferStorageFlags::None);
+
+		_instanceCapacity = instanceCapacity;
+
+		return true;
+	}
+
+	void FrustumCuller::setMeshes(const DrawElementsCommand* meshes, uint32_t count, uint32_t firstMesh)
+	{
+		assert(isValid());
+		assert((firstMesh + count) * sizeof(DrawElementsCommand) <= _meshBuffer.getSize());
+
+		_meshBuffer.update(meshes, count * sizeof(DrawElementsCommand), firstMesh * sizeof(DrawElementsCommand));
+	}
+
+	void FrustumCuller::setInstances(const CullingInstance* instances, uint32_t count, uint32_t firstInstance)
+	{
+		assert(isValid());
+		assert(firstInstance + count <= _instanceCapacity);
+
+		_instanceBuffer.update(instances, count * sizeof(CullingInstance), firstInstance * sizeof(CullingInstance));
+		_instanceCount = std::max(_instanceCount, firstInstance + count);
+	}
+
+	void FrustumCuller::setInstanceCount(uint32_t count)
+	{
+		assert(count <= _instanceCapacity);
+
+		_instanceCount = count;
+	}
+
+	void FrustumCuller::destroy()
+	{
+		_program.reset();
+
+		_instanceBuffer.destroy();
+		_meshBuffer.destroy();
+		_commandBuffer.destroy();
+		_countBuffer.destroy();
+
+		_instanceCount = 0;
+		_instanceCapacity = 0;
+	}
+
+	void FrustumCuller::cull(const scp::f32mat4x4& viewProjection)
+	{
+		assert(isValid());
+
+		_countBuffer.clear(0u);
+
+		if (_instanceCount == 0)
+		{
+			return;
+		}
+
+		const Buffer* buffers[] = { &_instanceBuffer, &_meshBuffer, &_commandBuffer, &_countBuffer };
+		Buffer::bind(BufferTarget::ShaderStorage, buffers, 0, 4);
+
+		_program->setUniform("viewProjection"_u, viewProjection);
+		_program->setUniform("instanceCount"_u, _instanceCount);
+		_program->dispatch({ (_instanceCount + _workGroupSize - 1) / _workGroupSize, 1, 1 });
+	}
+
+	void FrustumCuller::draw(const VertexArray& vertexArray, PrimitiveType primitiveType, IndexType indexType) const
+	{
+		assert(isValid());
+
+		if (_instanceCount == 0)
+		{
+			return;
+		}
+
+		vertexArray.multiDrawElementsIndirectCount(primitiveType, indexType, _commandBuffer, _countBuffer, _instanceCount);
+	}
+
+	const Buffer& FrustumCuller::getInstanceBuffer() const
+	{
+		return _instanceBuffer;
+	}
+
+	const Buffer& FrustumCuller::getMeshBuffer() const
+	{
+		return _meshBuffer;
+	}
+
+	const Buffer& FrustumCuller::getCommandBuffer() const
+	{
+		return _commandBuffer;
+	}
+
+	const Buffer& FrustumCuller::getCountBuffer() const
+	{
+		return _countBuffer;
+	}
+
+	uint32_t FrustumCuller::getInstanceCount() const
+	{
+		return _instanceCount;
+	}
+
+	uint32_t FrustumCuller::getInstanceCapacity() const
+	{
+		return _instanceCapacity;
+	}
+
+	bool FrustumCuller::isValid() const
+	{
+		return _program != nullptr;
+	}
+
+	FrustumCuller::~FrustumCuller()
+	{
+		destroy();
+	}
+}
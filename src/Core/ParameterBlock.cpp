@@ -0,0 +1,330 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2021-2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <SplayLibrary/Core/Core.hpp>
+#include <SplayLibrary/Private/PrivateNotIncluded.hpp>
+
+namespace spl
+{
+	namespace
+	{
+		struct TypeLayout
+		{
+			uint8_t columns;
+			uint8_t rows;
+			uint8_t componentSize;	// In the block, bools are stored as 4 bytes while they are 1 byte on the CPU
+		};
+
+		constexpr TypeLayout glslTypeToLayout(GlslType type)
+		{
+			switch (type)
+			{
+				case GlslType::Float:
+				case GlslType::Int:
+				case GlslType::UnsignedInt:
+				case GlslType::Bool:
+					return { 1, 1, 4 };
+				case GlslType::FloatVec2:
+				case GlslType::IntVec2:
+				case GlslType::UnsignedIntVec2:
+				case GlslType::BoolVec2:
+					return { 1, 2, 4 };
+				case GlslType::FloatVec3:
+				case GlslType::IntVec3:
+				case GlslType::UnsignedIntVec3:
+				case GlslType::BoolVec3:
+					return { 1, 3, 4 };
+				case GlslType::FloatVec4:
+				case GlslType::IntVec4:
+				case GlslType::UnsignedIntVec4:
+				case GlslType::BoolVec4:
+					return { 1, 4, 4 };
+				case GlslType::Double:
+					return { 1, 1, 8 };
+				case GlslType::DoubleVec2:
+					return { 1, 2, 8 };
+				case GlslType::DoubleVec3:
+					return { 1, 3, 8 };
+				case GlslType::DoubleVec4:
+					return { 1, 4, 8 };
+				case GlslType::FloatMat2x2:
+					return { 2, 2, 4 };
+				case GlslType::FloatMat2x3:
+					return { 2, 3, 4 };
+				case GlslType::FloatMat2x4:
+					return { 2, 4, 4 };
+				case GlslType::FloatMat3x2:
+					return { 3, 2, 4 };
+				case GlslType::FloatMat3x3:
+					return { 3, 3, 4 };
+				case GlslType::FloatMat3x4:
+					return { 3, 4, 4 };
+				case GlslType::FloatMat4x2:
+					return { 4, 2, 4 };
+				case GlslType::FloatMat4x3:
+					return { 4, 3, 4 };
+				case GlslType::FloatMat4x4:
+					return { 4, 4, 4 };
+				case GlslType::DoubleMat2x2:
+					return { 2, 2, 8 };
+				case GlslType::DoubleMat2x3:
+					return { 2, 3, 8 };
+				case GlslType::DoubleMat2x4:
+					return { 2, 4, 8 };
+				case GlslType::DoubleMat3x2:
+					return { 3, 2, 8 };
+				case GlslType::DoubleMat3x3:
+					return { 3, 3, 8 };
+				case GlslType::DoubleMat3x4:
+					return { 3, 4, 8 };
+				case GlslType::DoubleMat4x2:
+					return { 4, 2, 8 };
+				case GlslType::DoubleMat4x3:
+					return { 4, 3, 8 };
+				case GlslType::DoubleMat4x4:
+					return { 4, 4, 8 };
+				default:
+					assert(false);	// Opaque types cannot be members of a uniform block
+					return { 0, 0, 0 };
+			}
+		}
+
+		constexpr bool isBoolType(GlslType type)
+		{
+			return type == GlslType::Bool || type == GlslType::BoolVec2 || type == GlslType::BoolVec3 || type == GlslType::BoolVec4;
+		}
+
+		const ShaderProgramResourceInfos* findUniformBlock(const ShaderProgram& program, uint64_t blockNameHash)
+		{
+			const ShaderProgramInterfaceInfos& interfaceInfos = program.getInterfaceInfos(ShaderProgramInterface::UniformBlock);
+			for (int32_t i = 0; i < interfaceInfos.activeResources; ++i)
+			{
+				const ShaderProgramResourceInfos& infos = program.getResourceInfos(ShaderProgramInterface::UniformBlock, i);
+				if (Name(infos.name).hash == blockNameHash)
+				{
+					return &infos;
+				}
+			}
+
+			return nullptr;
+		}
+	}
+
+	ParameterBlock::ParameterBlock() :
+		_blockNameHash(0),
+		_bindingIndex(-1),
+		_members(),
+		_staging(),
+		_isDirty(false),
+		_buffer(),
+		_sliceStride(0),
+		_sliceCount(0),
+		_currentSlice(0),
+		_uploadCount(0)
+	{
+	}
+
+	ParameterBlock::ParameterBlock(const ShaderProgram& program, const std::string& blockName, uint32_t sliceCount) : ParameterBlock()
+	{
+		createFromProgram(program, blockName, sliceCount);
+	}
+
+	bool ParameterBlock::createFromProgram(const ShaderProgram& program, const std::string& blockName, uint32_t sliceCount)
+	{
+		assert(program.isValid());
+		assert(!(program.getFlags() & ShaderProgramFlags::NoIntrospection));
+		assert(sliceCount != 0);
+
+		destroy();
+
+		const ShaderProgramResourceInfos* blockInfos = findUniformBlock(program, Name(blockName).hash);
+		if (!blockInfos || blockInfos->bufferDataSize == 0)
+		{
+			return false;
+		}
+
+		// Members are named "member" or "BlockName.member" (when the block has an instance name), and arrays of basic
+		// types "member[0]". They are all stored by "member".
+
+		const std::string prefix = blockName + ".";
+		for (uint32_t uniformIndex : blockInfos->activeVariables)
+		{
+			const ShaderProgramResourceInfos& infos = program.getResourceInfos(ShaderProgramInterface::Uniform, uniformIndex);
+
+			std::string_view name = infos.name;
+			if (name.starts_with(prefix))
+			{
+				name.remove_prefix(prefix.size());
+			}
+			if (name.ends_with("[0]"))
+			{
+				name.remove_suffix(3);
+			}
+
+			Member& member = _members[Name(name).hash];
+			member.type = infos.type;
+			member.offset = infos.offset;
+			member.arraySize = std::max(infos.arraySize, 1u);
+			member.arrayStride = infos.arrayStride;
+			member.matrixStride = infos.matrixStride;
+			member.isRowMajor = infos.isRowMajor;
+		}
+
+		_blockNameHash = Name(blockName).hash;
+		_bindingIndex = blockInfos->bufferBinding;
+
+		_staging.assign(blockInfos->bufferDataSize, 0);
+		_isDirty = true;
+
+		// Each slice must start at a multiple of the uniform buffer offset alignment
+
+		const uintptr_t alignment = Context::getCurrentContext()->getImplementationDependentValues().shader.uniformBufferOffsetAlignment;
+		_sliceStride = ((_staging.size() + alignment - 1) / alignment) * alignment;
+		_sliceCount = sliceCount;
+		_currentSlice = sliceCount - 1;
+
+		_buffer.createNew(_sliceStride * _sliceCount, BufferStorageFlags::DynamicStorage);
+
+		return true;
+	}
+
+	void ParameterBlock::upload()
+	{
+		assert(isValid());
+
+		if (_isDirty)
+		{
+			_currentSlice = (_currentSlice + 1) % _sliceCount;
+			_buffer.update(_staging.data(), _staging.size(), getOffset());
+
+			_isDirty = false;
+			++_uploadCount;
+		}
+
+		const IndexedBufferBinding& binding = Context::getCurrentContext()->getIndexedBufferBinding(BufferTarget::Uniform, _bindingIndex);
+		if (binding.buffer != &_buffer || binding.offset != getOffset() || binding.size != _staging.size())
+		{
+			Buffer::bind(BufferTarget::Uniform, &_buffer, _bindingIndex, _staging.size(), getOffset());
+		}
+	}
+
+	void ParameterBlock::destroy()
+	{
+		_blockNameHash = 0;
+		_bindingIndex = -1;
+		_members.clear();
+
+		_staging.clear();
+		_isDirty = false;
+
+		_buffer.destroy();
+		_sliceStride = 0;
+		_sliceCount = 0;
+		_currentSlice = 0;
+		_uploadCount = 0;
+	}
+
+	bool ParameterBlock::isCompatible(const ShaderProgram& program) const
+	{
+		assert(isValid());
+
+		const ShaderProgramResourceInfos* blockInfos = findUniformBlock(program, _blockNameHash);
+
+		return blockInfos && blockInfos->bufferDataSize == _staging.size() && blockInfos->bufferBinding == _bindingIndex;
+	}
+
+	const Buffer& ParameterBlock::getBuffer() const
+	{
+		return _buffer;
+	}
+
+	uint32_t ParameterBlock::getBindingIndex() const
+	{
+		return _bindingIndex;
+	}
+
+	uintptr_t ParameterBlock::getSize() const
+	{
+		return _staging.size();
+	}
+
+	uintptr_t ParameterBlock::getOffset() const
+	{
+		return _currentSlice * _sliceStride;
+	}
+
+	uint32_t ParameterBlock::getUploadCount() const
+	{
+		return _uploadCount;
+	}
+
+	bool ParameterBlock::isValid() const
+	{
+		return _buffer.isValid();
+	}
+
+	ParameterBlock::~ParameterBlock()
+	{
+		destroy();
+	}
+
+	void ParameterBlock::_set(uint64_t nameHash, GlslType type, const void* values, uint32_t count)
+	{
+		assert(isValid());
+
+		const auto it = _members.find(nameHash);
+		if (it == _members.end())
+		{
+			return;
+		}
+
+		const Member& member = it->second;
+		assert(member.type == type);
+		assert(count <= member.arraySize);
+
+		// Values are tightly packed, with matrices in row-major order, and are spread in the block following its layout
+
+		const TypeLayout layout = glslTypeToLayout(type);
+		const uint8_t srcComponentSize = isBoolType(type) ? 1 : layout.componentSize;
+		const uint32_t srcElementSize = layout.columns * layout.rows * srcComponentSize;
+
+		const uint8_t* src = reinterpret_cast<const uint8_t*>(values);
+		for (uint32_t i = 0; i < count; ++i, src += srcElementSize)
+		{
+			uint8_t* dst = _staging.data() + member.offset + i * member.arrayStride;
+
+			if (isBoolType(type))
+			{
+				for (uint8_t j = 0; j < layout.rows; ++j)
+				{
+					const uint32_t value = src[j] != 0;
+					std::copy_n(reinterpret_cast<const uint8_t*>(&value), 4, dst + j * 4);
+				}
+			}
+			else if (layout.columns == 1)
+			{
+				std::copy_n(src, srcElementSize, dst);
+			}
+			else
+			{
+				for (uint8_t row = 0; row < layout.rows; ++row)
+				{
+					for (uint8_t column = 0; column < layout.columns; ++column)
+					{
+						const uint32_t dstOffset = member.isRowMajor
+							? row * member.matrixStride + column * layout.componentSize
+							: column * member.matrixStride + row * layout.componentSize;
+
+						std::copy_n(src + (row * layout.columns + column) * layout.componentSize, layout.componentSize, dst + dstOffset);
+					}
+				}
+			}
+		}
+
+		_isDirty = true;
+	}
+}
@@ -0,0 +1,96 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2021-2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <SplayLibrary/Core/Core.hpp>
+#include <SplayLibrary/Private/PrivateNotIncluded.hpp>
+
+namespace spl
+{
+	std::mutex ProgramCache::_mutex;
+	std::unordered_multimap<uint64_t, ProgramCache::Entry> ProgramCache::_programs;
+
+	std::shared_ptr<const ShaderProgram> ProgramCache::getProgram(const ShaderModule* const* shaders, uint8_t count, ShaderProgramFlags::Flags flags)
+	{
+		assert(count != 0 && count <= 5);
+
+		// Compute the key of the program. Module hashes are sorted, so that the order of the modules does not matter.
+
+		std::vector<uint64_t> moduleHashes(count);
+		for (uint8_t i = 0; i < count; ++i)
+		{
+			assert(shaders[i]->isValid());
+			moduleHashes[i] = shaders[i]->getSourceHash();
+		}
+		std::sort(moduleHashes.begin(), moduleHashes.end());
+
+		const Context* context = Context::getCurrentContext();
+
+		uint64_t key = _spl::fnv1a(reinterpret_cast<const char*>(&context), sizeof(const Context*));
+		key = _spl::fnv1a(reinterpret_cast<const char*>(&flags), sizeof(ShaderProgramFlags::Flags), key);
+		key = _spl::fnv1a(reinterpret_cast<const char*>(moduleHashes.data()), count * sizeof(uint64_t), key);
+
+		std::lock_guard lock(_mutex);
+
+		// Different programs may share the same hash, the whole key is compared
+
+		Entry* entry = nullptr;
+		const auto range = _programs.equal_range(key);
+		for (std::unordered_multimap<uint64_t, Entry>::iterator it = range.first; it != range.second; ++it)
+		{
+			if (it->second.context == context && it->second.flags == flags && it->second.moduleHashes == moduleHashes)
+			{
+				entry = &it->second;
+				break;
+			}
+		}
+
+		if (entry)
+		{
+			std::shared_ptr<const ShaderProgram> program = entry->program.lock();
+			if (program)
+			{
+				return program;
+			}
+		}
+
+		std::shared_ptr<ShaderProgram> newProgram = std::make_shared<ShaderProgram>(shaders, count, flags);
+		if (!newProgram->isValid())
+		{
+			return nullptr;
+		}
+
+		if (!entry)
+		{
+			entry = &_programs.emplace(key, Entry{ context, flags, std::move(moduleHashes) })->second;
+		}
+
+		entry->program = newProgram;
+
+		return newProgram;
+	}
+
+	uint32_t ProgramCache::collect()
+	{
+		std::lock_guard lock(_mutex);
+
+		return std::erase_if(_programs, [](const std::pair<const uint64_t, Entry>& entry) { return entry.second.program.expired(); });
+	}
+
+	uint32_t ProgramCache::getProgramCount()
+	{
+		std::lock_guard lock(_mutex);
+
+		return _programs.size();
+	}
+
+	void ProgramCache::_dropContext(const Context* context)
+	{
+		std::lock_guard lock(_mutex);
+
+		std::erase_if(_programs, [&](const std::pair<const uint64_t, Entry>& entry) { return entry.second.context == context; });
+	}
+}
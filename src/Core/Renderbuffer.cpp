@@ -14,10 +14,21 @@ namespace spl
 		_renderbuffer(0),
 		_size(width, height),
 		_internalFormat(internalFormat),
-		_samples(samples)
+		_samples(samples),
+		_label()
 	{
 		glCreateRenderbuffers(1, &_renderbuffer);
 		glNamedRenderbufferStorageMultisample(_renderbuffer, _samples, _spl::textureInternalFormatToGLenum(_internalFormat), _size.x, _size.y);
+
+		Context::_addRenderbufferMemory(_label, getMemorySize());
+	}
+
+	void Renderbuffer::setLabel(const std::string& label)
+	{
+		Context::_moveMemoryLabel(_label, label, getMemorySize());
+		glObjectLabel(GL_RENDERBUFFER, _renderbuffer, label.size(), label.data());
+
+		_label = label;
 	}
 
 	bool Renderbuffer::isValid() const
@@ -45,9 +56,21 @@ namespace spl
 		return _samples;
 	}
 
+	const std::string& Renderbuffer::getLabel() const
+	{
+		return _label;
+	}
+
+	uint64_t Renderbuffer::getMemorySize() const
+	{
+		const uint64_t texelCount = static_cast<uint64_t>(_size.x) * _size.y * std::max(_samples, 1u);
+		return (texelCount * _spl::textureInternalFormatToTexelBits(_internalFormat) + 7) / 8;
+	}
+
 	Renderbuffer::~Renderbuffer()
 	{
 		_detachFramebuffers();
+		Context::_addRenderbufferMemory(_label, -static_cast<int64_t>(getMemorySize()));
 		glDeleteRenderbuffers(1, &_renderbuffer);
 	}
 }
@@ -23,7 +23,9 @@ namespace spl
 		_maxAnisotropy(1.f),
 		_sWrap(TextureWrapping::Repeat),
 		_tWrap(TextureWrapping::Repeat),
-		_rWrap(TextureWrapping::Repeat)
+		_rWrap(TextureWrapping::Repeat),
+		_contextBindings(),
+		_hasBindlessHandle(false)
 	{
 		glCreateSamplers(1, &_sampler);
 	}
@@ -56,6 +58,7 @@ namespace spl
 	void Sampler::setBorderColor(float r, float g, float b, float a)
 	{
 		assert(isValid());
+		assert(!_hasBindlessHandle);
 
 		_borderColor.x = r;
 		_borderColor.y = g;
@@ -67,6 +70,7 @@ namespace spl
 	void Sampler::setCompareMode(TextureCompareMode compareMode)
 	{
 		assert(isValid());
+		assert(!_hasBindlessHandle);
 
 		_compareMode = compareMode;
 		glSamplerParameteri(_sampler, GL_TEXTURE_COMPARE_MODE, _spl::textureCompareModeToGLenum(_compareMode));
@@ -75,6 +79,7 @@ namespace spl
 	void Sampler::setCompareFunc(CompareFunc compareFunc)
 	{
 		assert(isValid());
+		assert(!_hasBindlessHandle);
 
 		_compareFunc = compareFunc;
 		glSamplerParameteri(_sampler, GL_TEXTURE_COMPARE_FUNC, _spl::compareFuncToGLenum(_compareFunc));
@@ -83,6 +88,7 @@ namespace spl
 	void Sampler::setMinLod(float lod)
 	{
 		assert(isValid());
+		assert(!_hasBindlessHandle);
 
 		_minLod = lod;
 		glSamplerParameterf(_sampler, GL_TEXTURE_MIN_LOD, _minLod);
@@ -91,6 +97,7 @@ namespace spl
 	void Sampler::setMaxLod(float lod)
 	{
 		assert(isValid());
+		assert(!_hasBindlessHandle);
 
 		_maxLod = lod;
 		glSamplerParameterf(_sampler, GL_TEXTURE_MAX_LOD, _maxLod);
@@ -99,6 +106,7 @@ namespace spl
 	void Sampler::setLodBias(float bias)
 	{
 		assert(isValid());
+		assert(!_hasBindlessHandle);
 
 		_lodBias = bias;
 		glSamplerParameterf(_sampler, GL_TEXTURE_LOD_BIAS, _lodBias);
@@ -107,6 +115,7 @@ namespace spl
 	void Sampler::setMinFiltering(TextureFiltering filtering)
 	{
 		assert(isValid());
+		assert(!_hasBindlessHandle);
 
 		_minFilter = filtering;
 		glSamplerParameteri(_sampler, GL_TEXTURE_MIN_FILTER, _spl::textureFilteringToGLenum(_minFilter));
@@ -115,6 +124,7 @@ namespace spl
 	void Sampler::setMagFiltering(TextureFiltering filtering)
 	{
 		assert(isValid());
+		assert(!_hasBindlessHandle);
 
 		_magFilter = filtering;
 		glSamplerParameteri(_sampler, GL_TEXTURE_MAG_FILTER, _spl::textureFilteringToGLenum(_magFilter));
@@ -123,6 +133,7 @@ namespace spl
 	void Sampler::setMaxAnisotropy(float maxAnisotropy)
 	{
 		assert(isValid());
+		assert(!_hasBindlessHandle);
 		assert(maxAnisotropy >= 1.f);
 
 		_maxAnisotropy = maxAnisotropy;
@@ -132,6 +143,7 @@ namespace spl
 	void Sampler::setWrappingS(TextureWrapping wrap)
 	{
 		assert(isValid());
+		assert(!_hasBindlessHandle);
 
 		_sWrap = wrap;
 		glSamplerParameteri(_sampler, GL_TEXTURE_WRAP_S, _spl::textureWrappingToGLenum(_sWrap));
@@ -140,6 +152,7 @@ namespace spl
 	void Sampler::setWrappingT(TextureWrapping wrap)
 	{
 		assert(isValid());
+		assert(!_hasBindlessHandle);
 
 		_tWrap = wrap;
 		glSamplerParameteri(_sampler, GL_TEXTURE_WRAP_T, _spl::textureWrappingToGLenum(_tWrap));
@@ -148,6 +161,7 @@ namespace spl
 	void Sampler::setWrappingR(TextureWrapping wrap)
 	{
 		assert(isValid());
+		assert(!_hasBindlessHandle);
 
 		_rWrap = wrap;
 		glSamplerParameteri(_sampler, GL_TEXTURE_WRAP_R, _spl::textureWrappingToGLenum(_rWrap));
@@ -158,6 +172,11 @@ namespace spl
 		return _sampler != 0;
 	}
 
+	uint32_t Sampler::getHandle() const
+	{
+		return _sampler;
+	}
+
 	const scp::f32vec4& Sampler::getBorderColor() const
 	{
 		return _borderColor;
@@ -225,12 +244,12 @@ namespace spl
 
 	void Sampler::bind(const Sampler* sampler, uint32_t textureUnit)
 	{
-		std::vector<const Sampler*>& contextSamplers = Context::getCurrentContext()->_state.samplerBindings;
+		Context* context = Context::getCurrentContext();
 
 		assert(sampler == nullptr || sampler->isValid());
-		assert(textureUnit < contextSamplers.size());
+		assert(textureUnit < context->_state.samplerBindings.size());
 
-		contextSamplers[textureUnit] = sampler;
+		context->_setSamplerBinding(textureUnit, sampler);
 
 		if (sampler)
 		{
@@ -244,19 +263,25 @@ namespace spl
 
 	void Sampler::bind(const Sampler* const* samplers, uint32_t firstUnit, uint32_t count)
 	{
-		std::vector<const Sampler*>& contextSamplers = Context::getCurrentContext()->_state.samplerBindings;
+		Context* context = Context::getCurrentContext();
 
-		assert(firstUnit + count <= contextSamplers.size());
+		assert(firstUnit + count <= context->_state.samplerBindings.size());
 
 		if (samplers == nullptr)
 		{
-			std::fill_n(contextSamplers.begin() + firstUnit, count, nullptr);
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				context->_setSamplerBinding(firstUnit + i, nullptr);
+			}
 
 			glBindSamplers(firstUnit, count, nullptr);
 		}
 		else
 		{
-			std::copy_n(samplers, count, contextSamplers.begin() + firstUnit);
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				context->_setSamplerBinding(firstUnit + i, samplers[i]);
+			}
 
 			uint32_t* names = reinterpret_cast<uint32_t*>(alloca(sizeof(uint32_t) * count));
 			for (uint32_t i = 0; i < count; ++i)
@@ -312,13 +337,17 @@ namespace spl
 
 		sampler._sampler = 0;
 
-		Context* context = Context::getCurrentContext();
-		for (uint8_t i = 0; i < context->_state.samplerBindings.size(); ++i)
+		_contextBindings = std::move(sampler._contextBindings);
+		sampler._contextBindings.clear();
+
+		_hasBindlessHandle = sampler._hasBindlessHandle;
+		sampler._hasBindlessHandle = false;
+
+		// Each binding is in the state of the context it was made in
+
+		for (const auto& [context, textureUnit] : _contextBindings)
 		{
-			if (context->_state.samplerBindings[i] == &sampler)
-			{
-				context->_state.samplerBindings[i] = this;
-			}
+			context->_state.samplerBindings[textureUnit] = this;
 		}
 	}
 
@@ -329,6 +358,7 @@ namespace spl
 			Context::getCurrentContext()->_unbindSampler(this);
 			glDeleteSamplers(1, &_sampler);
 			_sampler = 0;
+			_hasBindlessHandle = false;
 		}
 	}
 }
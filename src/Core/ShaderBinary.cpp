@@ -0,0 +1,159 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2021-2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <SplayLibrary/Core/Core.hpp>
+#include <SplayLibrary/Private/PrivateNotIncluded.hpp>
+
+namespace spl
+{
+	ShaderBinary::ShaderBinary() :
+		_format(0),
+		_data()
+	{
+	}
+
+	ShaderBinary::ShaderBinary(const ShaderProgram& program) : ShaderBinary()
+	{
+		createFromProgram(program);
+	}
+
+	ShaderBinary::ShaderBinary(const std::filesystem::path& path) : ShaderBinary()
+	{
+		createFromFile(path);
+	}
+
+	ShaderBinary::ShaderBinary(uint32_t format, const void* data, uint32_t size) : ShaderBinary()
+	{
+		createFromData(format, data, size);
+	}
+
+	bool ShaderBinary::createFromProgram(const ShaderProgram& program)
+	{
+		assert(program.isValid());
+		assert(program.getFlags() & ShaderProgramFlags::BinaryRetrievable);
+
+		destroy();
+
+		int32_t size = 0;
+		glGetProgramiv(program.getHandle(), GL_PROGRAM_BINARY_LENGTH, &size);
+
+		if (size <= 0)
+		{
+			return false;
+		}
+
+		_data.resize(size);
+		glGetProgramBinary(program.getHandle(), size, nullptr, &_format, _data.data());
+
+		return true;
+	}
+
+	bool ShaderBinary::createFromFile(const std::filesystem::path& path)
+	{
+		destroy();
+
+		std::ifstream file(path, std::ios::ate | std::ios::binary);
+		if (!file)
+		{
+			return false;
+		}
+
+		const uint64_t fileSize = file.tellg();
+		file.seekg(0);
+
+		// The size in the header is checked against the file size, to never trust a corrupted file for an allocation
+
+		uint32_t header[4];
+		file.read(reinterpret_cast<char*>(header), sizeof(header));
+		if (!file || header[0] != _fileMagic || header[1] != _fileVersion || header[3] == 0 || header[3] != fileSize - sizeof(header))
+		{
+			return false;
+		}
+
+		_data.resize(header[3]);
+		file.read(reinterpret_cast<char*>(_data.data()), _data.size());
+		if (!file)
+		{
+			_data.clear();
+			return false;
+		}
+
+		_format = header[2];
+
+		return true;
+	}
+
+	void ShaderBinary::createFromData(uint32_t format, const void* data, uint32_t size)
+	{
+		assert(data != nullptr);
+		assert(size != 0);
+
+		_format = format;
+		_data.assign(reinterpret_cast<const uint8_t*>(data), reinterpret_cast<const uint8_t*>(data) + size);
+	}
+
+	bool ShaderBinary::saveToFile(const std::filesystem::path& path) const
+	{
+		assert(isValid());
+
+		// Write a temporary file and rename it, so that a crash cannot leave a truncated file at "path"
+
+		std::filesystem::path tmpPath = path;
+		tmpPath += ".tmp";
+
+		{
+			std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+			if (!file)
+			{
+				return false;
+			}
+
+			const uint32_t header[4] = { _fileMagic, _fileVersion, _format, static_cast<uint32_t>(_data.size()) };
+			file.write(reinterpret_cast<const char*>(header), sizeof(header));
+			file.write(reinterpret_cast<const char*>(_data.data()), _data.size());
+			file.close();
+
+			if (!file)
+			{
+				std::error_code error;
+				std::filesystem::remove(tmpPath, error);
+				return false;
+			}
+		}
+
+		std::error_code error;
+		std::filesystem::rename(tmpPath, path, error);
+
+		return !error;
+	}
+
+	void ShaderBinary::destroy()
+	{
+		_format = 0;
+		_data.clear();
+	}
+
+	uint32_t ShaderBinary::getFormat() const
+	{
+		return _format;
+	}
+
+	const void* ShaderBinary::getData() const
+	{
+		return _data.data();
+	}
+
+	uint32_t ShaderBinary::getSize() const
+	{
+		return _data.size();
+	}
+
+	bool ShaderBinary::isValid() const
+	{
+		return !_data.empty();
+	}
+}
@@ -0,0 +1,218 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2021-2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <SplayLibrary/Core/Core.hpp>
+#include <SplayLibrary/Private/PrivateNotIncluded.hpp>
+
+namespace spl
+{
+	namespace
+	{
+		bool loadFile(const std::filesystem::path& path, std::string& content)
+		{
+			std::ifstream file(path, std::ios::ate | std::ios::binary);
+			if (!file)
+			{
+				return false;
+			}
+
+			content.resize(file.tellg());
+			file.seekg(0);
+			file.read(content.data(), content.size());
+
+			return static_cast<bool>(file);
+		}
+
+		void saveIntrospection(const ShaderProgram& program, uint64_t key, const std::filesystem::path& path)
+		{
+			std::vector<uint8_t> data;
+			program.serializeIntrospection(data, key);
+
+			// Same as ShaderBinary::saveToFile: a temporary file is renamed once complete
+
+			std::filesystem::path tmpPath = path;
+			tmpPath += ".tmp";
+
+			std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+			file.write(reinterpret_cast<const char*>(data.data()), data.size());
+			file.close();
+
+			std::error_code error;
+			if (file)
+			{
+				std::filesystem::rename(tmpPath, path, error);
+			}
+			else
+			{
+				std::filesystem::remove(tmpPath, error);
+			}
+		}
+
+		uint64_t computeDriverHash()
+		{
+			const ImplementationDependentValues& impl = Context::getCurrentContext()->getImplementationDependentValues();
+			const char* version = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+
+			uint64_t hash = _spl::fnv1a(impl.version.vendor.data(), impl.version.vendor.size());
+			hash = _spl::fnv1a(impl.version.renderer.data(), impl.version.renderer.size(), hash);
+			hash = _spl::fnv1a(version, std::char_traits<char>::length(version), hash);
+
+			return hash;
+		}
+	}
+
+	ShaderBinaryCache::ShaderBinaryCache() :
+		_directory(),
+		_hitCount(0),
+		_missCount(0)
+	{
+	}
+
+	ShaderBinaryCache::ShaderBinaryCache(const std::filesystem::path& directory) : ShaderBinaryCache()
+	{
+		setDirectory(directory);
+	}
+
+	void ShaderBinaryCache::setDirectory(const std::filesystem::path& directory)
+	{
+		_directory = directory;
+	}
+
+	bool ShaderBinaryCache::createProgram(ShaderProgram& program, const ShaderStage::Stage* stages, const std::filesystem::path* glslFiles, uint8_t count, const std::string& defines, ShaderProgramFlags::Flags flags)
+	{
+		assert(count != 0 && count <= 5);
+
+		std::string sources[5];
+		const char* sourceArray[5];
+		uint32_t sizeArray[5];
+
+		for (uint8_t i = 0; i < count; ++i)
+		{
+			if (!loadFile(glslFiles[i], sources[i]))
+			{
+				return false;
+			}
+
+			sourceArray[i] = sources[i].data();
+			sizeArray[i] = sources[i].size();
+		}
+
+		return createProgram(program, stages, sourceArray, sizeArray, count, defines, flags);
+	}
+
+	bool ShaderBinaryCache::createProgram(ShaderProgram& program, const ShaderStage::Stage* stages, const char* const* sources, const uint32_t* sizes, uint8_t count, const std::string& defines, ShaderProgramFlags::Flags flags)
+	{
+		assert(!_directory.empty());
+		assert(count != 0 && count <= 5);
+
+		const ShaderProgramFlags::Flags programFlags = static_cast<ShaderProgramFlags::Flags>(flags | ShaderProgramFlags::BinaryRetrievable);
+
+		// Compute the key of the program
+
+		std::string finalSources[5];
+
+		uint64_t key = computeDriverHash();
+		key = _spl::fnv1a(reinterpret_cast<const char*>(&programFlags), sizeof(programFlags), key);
+		for (uint8_t i = 0; i < count; ++i)
+		{
+			finalSources[i] = ShaderModule::_injectDefines(sources[i], sizes[i], defines);
+
+			key = _spl::fnv1a(reinterpret_cast<const char*>(stages + i), sizeof(ShaderStage::Stage), key);
+			key = _spl::fnv1a(finalSources[i].data(), finalSources[i].size(), key);
+		}
+
+		char keyString[17] = {};
+		std::to_chars(keyString, keyString + 16, key, 16);
+		const std::filesystem::path path = _directory / (std::string(keyString) + ".bin");
+		const std::filesystem::path introspectionPath = _directory / (std::string(keyString) + ".reflect");
+		const bool introspection = !(programFlags & ShaderProgramFlags::NoIntrospection);
+
+		// Try to load the binary, and its introspection data to skip reflection queries
+
+		std::error_code error;
+		if (std::filesystem::exists(path, error))
+		{
+			ShaderBinary binary;
+			if (binary.createFromFile(path) && program.createFromBinary(binary, programFlags))
+			{
+				if (introspection)
+				{
+					std::string introspectionData;
+					if (!loadFile(introspectionPath, introspectionData) || !program.deserializeIntrospection(introspectionData.data(), introspectionData.size(), key))
+					{
+						saveIntrospection(program, key, introspectionPath);
+					}
+				}
+
+				++_hitCount;
+				return true;
+			}
+
+			std::filesystem::remove(path, error);
+			std::filesystem::remove(introspectionPath, error);
+		}
+
+		++_missCount;
+
+		// Compile from sources and save the binary
+
+		ShaderModule modules[5];
+		const ShaderModule* moduleArray[5];
+
+		for (uint8_t i = 0; i < count; ++i)
+		{
+			if (!modules[i].createFromGlsl(stages[i], finalSources[i].data(), finalSources[i].size()))
+			{
+				return false;
+			}
+
+			moduleArray[i] = modules + i;
+		}
+
+		if (!program.createFromShaderModules(moduleArray, count, programFlags))
+		{
+			return false;
+		}
+
+		std::filesystem::create_directories(_directory, error);
+
+		const ShaderBinary binary(program);
+		if (binary.isValid() && binary.saveToFile(path) && introspection)
+		{
+			saveIntrospection(program, key, introspectionPath);
+		}
+
+		return true;
+	}
+
+	void ShaderBinaryCache::clear()
+	{
+		std::error_code error;
+		for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(_directory, error))
+		{
+			if (entry.path().extension() == ".bin" || entry.path().extension() == ".reflect")
+			{
+				std::filesystem::remove(entry.path(), error);
+			}
+		}
+	}
+
+	const std::filesystem::path& ShaderBinaryCache::getDirectory() const
+	{
+		return _directory;
+	}
+
+	uint32_t ShaderBinaryCache::getHitCount() const
+	{
+		return _hitCount;
+	}
+
+	uint32_t ShaderBinaryCache::getMissCount() const
+	{
+		return _missCount;
+	}
+}
@@ -13,7 +13,8 @@ namespace spl
 	ShaderModule::ShaderModule() :
 		_shader(0),
 		_stage(ShaderStage::None),
-		_compileStatus(0)
+		_compileStatus(0),
+		_sourceHash(0)
 	{
 	}
 
@@ -42,6 +43,11 @@ namespace spl
 		createFromSpirV(stage, binary, size, entryPoint, constantIndices, constantValues, specializationConstantsCount);
 	}
 
+	ShaderModule::ShaderModule(const EmbeddedSpirV& spirv, const char* entryPoint, const uint32_t* constantIndices, const void* constantValues, uint32_t specializationConstantsCount) : ShaderModule()
+	{
+		createFromSpirV(spirv, entryPoint, constantIndices, constantValues, specializationConstantsCount);
+	}
+
 	bool ShaderModule::createFromGlsl(ShaderStage::Stage stage, const std::filesystem::path& glslFile)
 	{
 		bool success = false;
@@ -64,8 +70,27 @@ namespace spl
 
 	bool ShaderModule::createFromGlsl(ShaderStage::Stage stage, const char* const* sources, const uint32_t* sizes, uint32_t count)
 	{
-		assert(count != 0);
+		createFromGlslAsync(stage, sources, sizes, count);
+		return waitCompilation();
+	}
+
+	bool ShaderModule::createFromSpirV(ShaderStage::Stage stage, const std::filesystem::path& spirvFile, const char* entryPoint, const uint32_t* constantIndices, const void* constantValues, uint32_t specializationConstantsCount)
+	{
+		bool success = false;
+
+		char* data = nullptr;
+		uint32_t size = 0;
+		if (_loadFile(spirvFile, data, size))
+		{
+			success = createFromSpirV(stage, data, size, entryPoint, constantIndices, constantValues, specializationConstantsCount);
+			delete[] data;
+		}
+
+		return success;
+	}
 
+	bool ShaderModule::createFromSpirV(ShaderStage::Stage stage, const void* binary, uint32_t size, const char* entryPoint, const uint32_t* constantIndices, const void* constantValues, uint32_t specializationConstantsCount)
+	{
 		if (_shader != 0 && _stage != stage)
 		{
 			destroy();
@@ -77,8 +102,14 @@ namespace spl
 			_stage = stage;
 		}
 
-		glShaderSource(_shader, count, sources, reinterpret_cast<const GLint*>(sizes));
-		glCompileShader(_shader);
+		_sourceHash = _spl::fnv1a(reinterpret_cast<const char*>(&stage), sizeof(ShaderStage::Stage));
+		_sourceHash = _spl::fnv1a(reinterpret_cast<const char*>(binary), size, _sourceHash);
+		_sourceHash = _spl::fnv1a(entryPoint, std::char_traits<char>::length(entryPoint) + 1, _sourceHash);
+		_sourceHash = _spl::fnv1a(reinterpret_cast<const char*>(constantIndices), specializationConstantsCount * sizeof(uint32_t), _sourceHash);
+		_sourceHash = _spl::fnv1a(reinterpret_cast<const char*>(constantValues), specializationConstantsCount * sizeof(uint32_t), _sourceHash);
+
+		glShaderBinary(1, &_shader, GL_SHADER_BINARY_FORMAT_SPIR_V, binary, size);
+		glSpecializeShader(_shader, entryPoint, specializationConstantsCount, constantIndices, reinterpret_cast<const GLuint*>(constantValues));
 		glGetShaderiv(_shader, GL_COMPILE_STATUS, &_compileStatus);
 
 		if (!_compileStatus)
@@ -95,23 +126,37 @@ namespace spl
 		return _compileStatus;
 	}
 
-	bool ShaderModule::createFromSpirV(ShaderStage::Stage stage, const std::filesystem::path& spirvFile, const char* entryPoint, const uint32_t* constantIndices, const void* constantValues, uint32_t specializationConstantsCount)
+	bool ShaderModule::createFromSpirV(const EmbeddedSpirV& spirv, const char* entryPoint, const uint32_t* constantIndices, const void* constantValues, uint32_t specializationConstantsCount)
 	{
-		bool success = false;
+		assert(spirv.data != nullptr);
+
+		return createFromSpirV(spirv.stage, spirv.data, spirv.size, entryPoint, constantIndices, constantValues, specializationConstantsCount);
+	}
 
+	bool ShaderModule::createFromGlslAsync(ShaderStage::Stage stage, const std::filesystem::path& glslFile)
+	{
 		char* data = nullptr;
 		uint32_t size = 0;
-		if (_loadFile(spirvFile, data, size))
+		if (!_loadFile(glslFile, data, size))
 		{
-			success = createFromSpirV(stage, data, size, entryPoint, constantIndices, constantValues, specializationConstantsCount);
-			delete[] data;
+			return false;
 		}
 
-		return success;
+		createFromGlslAsync(stage, data, size);
+		delete[] data;
+
+		return true;
 	}
 
-	bool ShaderModule::createFromSpirV(ShaderStage::Stage stage, const void* binary, uint32_t size, const char* entryPoint, const uint32_t* constantIndices, const void* constantValues, uint32_t specializationConstantsCount)
+	void ShaderModule::createFromGlslAsync(ShaderStage::Stage stage, const char* source, uint32_t size)
+	{
+		createFromGlslAsync(stage, &source, &size, 1);
+	}
+
+	void ShaderModule::createFromGlslAsync(ShaderStage::Stage stage, const char* const* sources, const uint32_t* sizes, uint32_t count)
 	{
+		assert(count != 0);
+
 		if (_shader != 0 && _stage != stage)
 		{
 			destroy();
@@ -123,8 +168,51 @@ namespace spl
 			_stage = stage;
 		}
 
-		glShaderBinary(1, &_shader, GL_SHADER_BINARY_FORMAT_SPIR_V, binary, size);
-		glSpecializeShader(_shader, entryPoint, specializationConstantsCount, constantIndices, reinterpret_cast<const GLuint*>(constantValues));
+		// The compile status is only queried in "waitCompilation", so that the driver can compile several shaders at
+		// the same time (on its own threads with KHR_parallel_shader_compile, or at least deferred).
+
+		_sourceHash = _spl::fnv1a(reinterpret_cast<const char*>(&stage), sizeof(ShaderStage::Stage));
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			_sourceHash = _spl::fnv1a(sources[i], sizes[i], _sourceHash);
+		}
+
+		glShaderSource(_shader, count, sources, reinterpret_cast<const GLint*>(sizes));
+		glCompileShader(_shader);
+		_compileStatus = _compilePending;
+	}
+
+	bool ShaderModule::isCompilationComplete() const
+	{
+		assert(_shader != 0);
+
+		if (_compileStatus != _compilePending)
+		{
+			return true;
+		}
+
+		// Without the extension there is no way to know, the compilation will be waited for at the first query
+
+		if (GLAD_GL_KHR_parallel_shader_compile || GLAD_GL_ARB_parallel_shader_compile)
+		{
+			int32_t completionStatus;
+			glGetShaderiv(_shader, GL_COMPLETION_STATUS_KHR, &completionStatus);
+
+			return completionStatus;
+		}
+
+		return true;
+	}
+
+	bool ShaderModule::waitCompilation()
+	{
+		assert(_shader != 0);
+
+		if (_compileStatus != _compilePending)
+		{
+			return _compileStatus;
+		}
+
 		glGetShaderiv(_shader, GL_COMPILE_STATUS, &_compileStatus);
 
 		if (!_compileStatus)
@@ -151,6 +239,7 @@ namespace spl
 		_shader = 0;
 		_stage = ShaderStage::None;
 		_compileStatus = 0;
+		_sourceHash = 0;
 	}
 
 	uint32_t ShaderModule::getHandle() const
@@ -158,9 +247,14 @@ namespace spl
 		return _shader;
 	}
 
+	uint64_t ShaderModule::getSourceHash() const
+	{
+		return _sourceHash;
+	}
+
 	bool ShaderModule::isValid() const
 	{
-		return _shader != 0 && _compileStatus != 0;
+		return _shader != 0 && _compileStatus > 0;
 	}
 
 	ShaderModule::~ShaderModule()
@@ -196,4 +290,43 @@ namespace spl
 
 		return true;
 	}
+
+	std::string ShaderModule::_injectDefines(const char* source, uint32_t size, const std::string& defines)
+	{
+		std::string result(source, size);
+
+		if (defines.empty())
+		{
+			return result;
+		}
+
+		// Insert the defines right after the "#version" line (which must be first) and restore line numbers
+
+		uint64_t insertPos = 0;
+		uint64_t nextLine = 1;
+
+		const uint64_t versionPos = result.find("#version");
+		if (versionPos != std::string::npos)
+		{
+			insertPos = result.find('\n', versionPos);
+			insertPos = (insertPos == std::string::npos) ? result.size() : insertPos + 1;
+			nextLine = std::count(result.begin(), result.begin() + insertPos, '\n') + 1;
+		}
+
+		std::string injected = defines;
+		if (injected.back() != '\n')
+		{
+			injected.push_back('\n');
+		}
+		injected += "#line " + std::to_string(nextLine) + "\n";
+
+		if (insertPos == result.size() && !result.empty() && result.back() != '\n')
+		{
+			injected.insert(injected.begin(), '\n');
+		}
+
+		result.insert(insertPos, injected);
+
+		return result;
+	}
 }
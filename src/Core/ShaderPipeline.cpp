@@ -0,0 +1,163 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2021-2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <SplayLibrary/Core/Core.hpp>
+#include <SplayLibrary/Private/PrivateNotIncluded.hpp>
+
+namespace spl
+{
+	ShaderPipeline::ShaderPipeline() :
+		_pipeline(0),
+		_stagePrograms(),
+		_stageProgramHandles()
+	{
+		_stagePrograms.fill(nullptr);
+		_stageProgramHandles.fill(0);
+	}
+
+	void ShaderPipeline::createNew()
+	{
+		destroy();
+
+		glCreateProgramPipelines(1, &_pipeline);
+	}
+
+	void ShaderPipeline::setStages(ShaderStage::Stage stages, const ShaderProgram* program)
+	{
+		assert(isValid());
+		assert(stages < (1 << _stageCount));
+		assert(program == nullptr || program->isValid());
+		assert(program == nullptr || (program->getFlags() & ShaderProgramFlags::Separable));
+
+		const uint32_t handle = program ? program->getHandle() : 0;
+
+		// Only the stages not already using this program are changed, and nothing is done if there is none
+
+		uint32_t changedStages = ShaderStage::None;
+		for (uint8_t i = 0; i < _stageCount; ++i)
+		{
+			if ((stages & (1 << i)) && (_stagePrograms[i] != program || _stageProgramHandles[i] != handle))
+			{
+				changedStages |= 1 << i;
+				_stagePrograms[i] = program;
+				_stageProgramHandles[i] = handle;
+			}
+		}
+
+		if (changedStages != ShaderStage::None)
+		{
+			glUseProgramStages(_pipeline, _spl::shaderStageToGLbitfield(static_cast<ShaderStage::Stage>(changedStages)), handle);
+
+			// Changing the stages of the active pipeline resets the subroutine uniforms
+
+			const Context* context = Context::getCurrentContext();
+			if (context->getShaderPipelineBinding() == this && !context->getShaderBinding())
+			{
+				_applySubroutines();
+			}
+		}
+	}
+
+	bool ShaderPipeline::validate() const
+	{
+		assert(isValid());
+
+		int32_t validateStatus;
+		glValidateProgramPipeline(_pipeline);
+		glGetProgramPipelineiv(_pipeline, GL_VALIDATE_STATUS, &validateStatus);
+
+		if (!validateStatus)
+		{
+			int32_t length;
+			glGetProgramPipelineiv(_pipeline, GL_INFO_LOG_LENGTH, &length);
+
+			char* buffer = reinterpret_cast<char*>(alloca(length));
+			glGetProgramPipelineInfoLog(_pipeline, length, nullptr, buffer);
+
+			glDebugMessageInsert(GL_DEBUG_SOURCE_APPLICATION, GL_DEBUG_TYPE_ERROR, 0, GL_DEBUG_SEVERITY_HIGH, length, buffer);
+		}
+
+		return validateStatus;
+	}
+
+	void ShaderPipeline::destroy()
+	{
+		Context::getCurrentContext()->_unbindShaderPipeline(this);
+
+		if (_pipeline != 0)
+		{
+			glDeleteProgramPipelines(1, &_pipeline);
+		}
+
+		_pipeline = 0;
+		_stagePrograms.fill(nullptr);
+		_stageProgramHandles.fill(0);
+	}
+
+	const ShaderProgram* ShaderPipeline::getStageProgram(ShaderStage::Stage stage) const
+	{
+		assert(std::has_single_bit(static_cast<uint32_t>(stage)) && stage < (1 << _stageCount));
+
+		return _stagePrograms[std::countr_zero(static_cast<uint32_t>(stage))];
+	}
+
+	uint32_t ShaderPipeline::getHandle() const
+	{
+		return _pipeline;
+	}
+
+	bool ShaderPipeline::isValid() const
+	{
+		return _pipeline != 0;
+	}
+
+	ShaderPipeline::~ShaderPipeline()
+	{
+		destroy();
+	}
+
+	void ShaderPipeline::bind(const ShaderPipeline* pipeline)
+	{
+		assert(pipeline == nullptr || pipeline->isValid());
+
+		Context* context = Context::getCurrentContext();
+
+		// A program bound with glUseProgram takes precedence over the pipeline. It is unbound directly, so that only the
+		// subroutines of the new pipeline are applied.
+
+		if (pipeline && context->_state.shaderBinding)
+		{
+			context->_state.shaderBinding = nullptr;
+			glUseProgram(0);
+		}
+
+		context->_state.shaderPipelineBinding = pipeline;
+
+		if (pipeline)
+		{
+			glBindProgramPipeline(pipeline->_pipeline);
+			pipeline->_applySubroutines();
+		}
+		else
+		{
+			glBindProgramPipeline(0);
+		}
+	}
+
+	void ShaderPipeline::_applySubroutines() const
+	{
+		// Subroutine uniforms are not part of the program state, they are lost each time the pipeline is bound
+
+		for (uint8_t i = 0; i < _stageCount; ++i)
+		{
+			if (_stagePrograms[i] && !_stagePrograms[i]->_subroutineSelections[i].empty())
+			{
+				_stagePrograms[i]->_applySubroutines(i);
+			}
+		}
+	}
+}
@@ -0,0 +1,282 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2021-2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <SplayLibrary/Core/Core.hpp>
+#include <SplayLibrary/Private/PrivateNotIncluded.hpp>
+
+namespace spl
+{
+	namespace
+	{
+		std::string normalizePath(const std::filesystem::path& path)
+		{
+			std::error_code error;
+			return std::filesystem::absolute(path, error).lexically_normal().string();
+		}
+
+		void reportError(const std::string& message)
+		{
+			glDebugMessageInsert(GL_DEBUG_SOURCE_APPLICATION, GL_DEBUG_TYPE_ERROR, 0, GL_DEBUG_SEVERITY_HIGH, message.size(), message.c_str());
+		}
+
+		std::string_view trimLeft(std::string_view text)
+		{
+			const uint64_t pos = text.find_first_not_of(" \t");
+			return pos == std::string_view::npos ? std::string_view() : text.substr(pos);
+		}
+
+		bool startsWithDirective(std::string_view line, std::string_view directive, std::string_view& arguments)
+		{
+			line = trimLeft(line);
+			if (!line.starts_with('#'))
+			{
+				return false;
+			}
+
+			line = trimLeft(line.substr(1));
+			if (!line.starts_with(directive) || (line.size() > directive.size() && line[directive.size()] != ' ' && line[directive.size()] != '\t'))
+			{
+				return false;
+			}
+
+			arguments = trimLeft(line.substr(directive.size()));
+			return true;
+		}
+	}
+
+	ShaderPreprocessor::ShaderPreprocessor() :
+		_includeDirectories(),
+		_modules(),
+		_permutations()
+	{
+	}
+
+	void ShaderPreprocessor::addIncludeDirectory(const std::filesystem::path& directory)
+	{
+		_includeDirectories.push_back(directory);
+	}
+
+	bool ShaderPreprocessor::preprocess(const std::filesystem::path& glslFile, const std::map<std::string, std::string>& defines, std::string& source, std::vector<std::filesystem::path>* dependencies) const
+	{
+		PreprocessingState state;
+
+		std::string includedSource;
+		if (!_preprocessFile(glslFile, state, includedSource))
+		{
+			return false;
+		}
+
+		std::string defineDirectives;
+		for (const std::pair<const std::string, std::string>& define : defines)
+		{
+			defineDirectives += "#define " + define.first + " " + define.second + "\n";
+		}
+
+		source = ShaderModule::_injectDefines(includedSource.data(), includedSource.size(), defineDirectives);
+
+		if (dependencies)
+		{
+			*dependencies = std::move(state.files);
+		}
+
+		return true;
+	}
+
+	const ShaderModule* ShaderPreprocessor::getModule(ShaderStage::Stage stage, const std::filesystem::path& glslFile, const std::map<std::string, std::string>& defines)
+	{
+		// Same file and defines as a previous request: the files are not read again
+
+		const std::tuple<ShaderStage::Stage, std::string, uint64_t> permutation(stage, normalizePath(glslFile), computePermutationKey(defines));
+
+		const std::map<std::tuple<ShaderStage::Stage, std::string, uint64_t>, const ShaderModule*>::const_iterator it = _permutations.find(permutation);
+		if (it != _permutations.end())
+		{
+			return it->second->isValid() ? it->second : nullptr;
+		}
+
+		std::string source;
+		if (!preprocess(glslFile, defines, source))
+		{
+			return nullptr;
+		}
+
+		uint64_t key = _spl::fnv1a(reinterpret_cast<const char*>(&stage), sizeof(ShaderStage::Stage));
+		key = _spl::fnv1a(source.data(), source.size(), key);
+
+		// Different sources may share the same hash, the whole source is compared
+
+		const ShaderModule* module = nullptr;
+
+		const auto range = _modules.equal_range(key);
+		for (std::unordered_multimap<uint64_t, ModuleEntry>::const_iterator moduleIt = range.first; moduleIt != range.second; ++moduleIt)
+		{
+			if (moduleIt->second.stage == stage && moduleIt->second.source == source)
+			{
+				module = moduleIt->second.module.get();
+				break;
+			}
+		}
+
+		// Modules that failed to compile are kept too, so that they are not compiled again
+
+		if (!module)
+		{
+			ModuleEntry entry;
+			entry.stage = stage;
+			entry.module = std::make_unique<ShaderModule>(stage, source.data(), source.size());
+			entry.source = std::move(source);
+
+			module = _modules.emplace(key, std::move(entry))->second.module.get();
+		}
+
+		_permutations[permutation] = module;
+
+		return module->isValid() ? module : nullptr;
+	}
+
+	void ShaderPreprocessor::clearModules()
+	{
+		_modules.clear();
+		_permutations.clear();
+	}
+
+	const std::vector<std::filesystem::path>& ShaderPreprocessor::getIncludeDirectories() const
+	{
+		return _includeDirectories;
+	}
+
+	uint32_t ShaderPreprocessor::getModuleCount() const
+	{
+		return _modules.size();
+	}
+
+	uint64_t ShaderPreprocessor::computePermutationKey(const std::map<std::string, std::string>& defines)
+	{
+		// The map is sorted, so the key does not depend on the insertion order
+
+		uint64_t key = _spl::fnv1a(nullptr, 0);
+		for (const std::pair<const std::string, std::string>& define : defines)
+		{
+			key = _spl::fnv1a(define.first.data(), define.first.size() + 1, key);
+			key = _spl::fnv1a(define.second.data(), define.second.size() + 1, key);
+		}
+
+		return key;
+	}
+
+	bool ShaderPreprocessor::_preprocessFile(const std::filesystem::path& path, PreprocessingState& state, std::string& source) const
+	{
+		const std::string normalizedPath = normalizePath(path);
+
+		if (state.pragmaOnceFiles.contains(normalizedPath))
+		{
+			return true;
+		}
+
+		if (std::find(state.includeStack.begin(), state.includeStack.end(), normalizedPath) != state.includeStack.end())
+		{
+			reportError("Recursive inclusion of \"" + normalizedPath + "\".");
+			return false;
+		}
+
+		std::ifstream file(path, std::ios::ate | std::ios::binary);
+		if (!file)
+		{
+			reportError("Cannot open GLSL file \"" + normalizedPath + "\".");
+			return false;
+		}
+
+		std::string content(file.tellg(), '\0');
+		file.seekg(0);
+		file.read(content.data(), content.size());
+
+		const uint32_t sourceNumber = state.files.size();
+		state.files.push_back(path);
+		state.includeStack.push_back(normalizedPath);
+
+		if (sourceNumber != 0)
+		{
+			source += "#line 1 " + std::to_string(sourceNumber) + "\n";
+		}
+
+		uint32_t lineNumber = 1;
+		for (uint64_t lineBegin = 0; lineBegin < content.size(); ++lineNumber)
+		{
+			uint64_t lineEnd = content.find('\n', lineBegin);
+			lineEnd = (lineEnd == std::string::npos) ? content.size() : lineEnd;
+
+			const std::string_view line(content.data() + lineBegin, lineEnd - lineBegin);
+			lineBegin = lineEnd + 1;
+
+			std::string_view arguments;
+			if (startsWithDirective(line, "include", arguments))
+			{
+				const bool isQuoted = arguments.starts_with('"');
+				const uint64_t nameEnd = arguments.find(isQuoted ? '"' : '>', 1);
+				if ((!isQuoted && !arguments.starts_with('<')) || nameEnd == std::string_view::npos)
+				{
+					reportError("Invalid #include in \"" + normalizedPath + "\" at line " + std::to_string(lineNumber) + ".");
+					return false;
+				}
+
+				const std::string name(arguments.substr(1, nameEnd - 1));
+				std::filesystem::path includePath;
+				if (!_resolveInclude(path, name, isQuoted, includePath))
+				{
+					reportError("Cannot find \"" + name + "\" included in \"" + normalizedPath + "\" at line " + std::to_string(lineNumber) + ".");
+					return false;
+				}
+
+				if (!_preprocessFile(includePath, state, source))
+				{
+					return false;
+				}
+
+				source += "#line " + std::to_string(lineNumber + 1) + " " + std::to_string(sourceNumber) + "\n";
+			}
+			else if (startsWithDirective(line, "pragma", arguments) && arguments.starts_with("once"))
+			{
+				state.pragmaOnceFiles.insert(normalizedPath);
+				source += "\n";
+			}
+			else
+			{
+				source += line;
+				source += "\n";
+			}
+		}
+
+		state.includeStack.pop_back();
+
+		return true;
+	}
+
+	bool ShaderPreprocessor::_resolveInclude(const std::filesystem::path& includingFile, const std::string& name, bool isQuoted, std::filesystem::path& path) const
+	{
+		std::error_code error;
+
+		if (isQuoted)
+		{
+			path = includingFile.parent_path() / name;
+			if (std::filesystem::is_regular_file(path, error))
+			{
+				return true;
+			}
+		}
+
+		for (const std::filesystem::path& directory : _includeDirectories)
+		{
+			path = directory / name;
+			if (std::filesystem::is_regular_file(path, error))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+}
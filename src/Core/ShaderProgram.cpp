@@ -10,14 +10,43 @@
 
 namespace spl
 {
+	namespace
+	{
+		constexpr GlslType glslTypeToUploadType(GlslType type)
+		{
+			// Bools are uploaded as ints, as well as the units of samplers and images
+
+			switch (type)
+			{
+				case GlslType::Bool:
+					return GlslType::Int;
+				case GlslType::BoolVec2:
+					return GlslType::IntVec2;
+				case GlslType::BoolVec3:
+					return GlslType::IntVec3;
+				case GlslType::BoolVec4:
+					return GlslType::IntVec4;
+				default:
+					return (type >= GlslType::Sampler1d) ? GlslType::Int : type;
+			}
+		}
+	}
+
 	ShaderProgram::ShaderProgram() :
 		_program(0),
 		_flags(ShaderProgramFlags::None),
 		_linkStatus(0),
+		_introspectedInterfaces(),
 		_interfacesInfos(),
 		_resourcesInfos(),
 		_locations(),
-		_locationIndices()
+		_uniformShadow(),
+		_uniformShadowOffsets(),
+		_uniformShadowInitialized(),
+		_uniformCacheHitCount(0),
+		_uniformCacheMissCount(0),
+		_subroutineSelections(),
+		_computeWorkGroupSize(0, 0, 0)
 	{
 	}
 
@@ -51,6 +80,11 @@ namespace spl
 		createFromShaderModules(shaders, count, flags);
 	}
 
+	ShaderProgram::ShaderProgram(const ShaderBinary& binary, ShaderProgramFlags::Flags flags) : ShaderProgram()
+	{
+		createFromBinary(binary, flags);
+	}
+
 	bool ShaderProgram::createFromGlsl(const std::filesystem::path& glslCompute, ShaderProgramFlags::Flags flags)
 	{
 		ShaderModule shader;
@@ -133,6 +167,44 @@ namespace spl
 			assert(shaders[i]->isValid());
 		}
 
+		createFromShaderModulesAsync(shaders, count, flags);
+		return waitLinking();
+	}
+
+	bool ShaderProgram::createFromBinary(const ShaderBinary& binary, ShaderProgramFlags::Flags flags)
+	{
+		assert(binary.isValid());
+
+		destroy();
+
+		_program = glCreateProgram();
+		_flags = flags;
+		glProgramParameteri(_program, GL_PROGRAM_SEPARABLE, ((_flags & ShaderProgramFlags::Separable) != 0));
+		glProgramParameteri(_program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, ((_flags & ShaderProgramFlags::BinaryRetrievable) != 0));
+
+		glProgramBinary(_program, binary.getFormat(), binary.getData(), binary.getSize());
+		glGetProgramiv(_program, GL_LINK_STATUS, &_linkStatus);
+
+		if (_linkStatus && (_flags & ShaderProgramFlags::EagerUniforms))
+		{
+			_shaderIntrospection(ShaderProgramInterface::Uniform);
+		}
+
+		// The driver can reject a binary (driver update, different GPU...) and this is not an error: the caller is
+		// expected to recompile the program from its sources.
+
+		return _linkStatus;
+	}
+
+	void ShaderProgram::createFromShaderModulesAsync(const ShaderModule* const* shaders, uint16_t count, ShaderProgramFlags::Flags flags)
+	{
+		// The modules may still be compiling: their compile errors will show up in the link log
+
+		for (uint16_t i = 0; i < count; ++i)
+		{
+			assert(shaders[i]->getHandle() != 0);
+		}
+
 		destroy();
 
 		_program = glCreateProgram();
@@ -145,13 +217,41 @@ namespace spl
 			glAttachShader(_program, shaders[i]->getHandle());
 		}
 		glLinkProgram(_program);
-		glGetProgramiv(_program, GL_LINK_STATUS, &_linkStatus);
+		_linkStatus = _linkPending;
+	}
+
+	bool ShaderProgram::isLinkingComplete() const
+	{
+		assert(_program != 0);
 
-		if (_linkStatus)
+		if (_linkStatus != _linkPending)
 		{
-			_shaderIntrospection();
+			return true;
 		}
-		else
+
+		if (GLAD_GL_KHR_parallel_shader_compile || GLAD_GL_ARB_parallel_shader_compile)
+		{
+			int32_t completionStatus;
+			glGetProgramiv(_program, GL_COMPLETION_STATUS_KHR, &completionStatus);
+
+			return completionStatus;
+		}
+
+		return true;
+	}
+
+	bool ShaderProgram::waitLinking()
+	{
+		assert(_program != 0);
+
+		if (_linkStatus != _linkPending)
+		{
+			return _linkStatus;
+		}
+
+		glGetProgramiv(_program, GL_LINK_STATUS, &_linkStatus);
+
+		if (!_linkStatus)
 		{
 			int32_t length;
 			glGetProgramiv(_program, GL_INFO_LOG_LENGTH, &length);
@@ -161,6 +261,12 @@ namespace spl
 
 			glDebugMessageInsert(GL_DEBUG_SOURCE_APPLICATION, GL_DEBUG_TYPE_ERROR, 0, GL_DEBUG_SEVERITY_HIGH, length, buffer);
 		}
+		else if (_flags & ShaderProgramFlags::EagerUniforms)
+		{
+			// Resolve the uniform locations now rather than on the first "setUniform"
+
+			_shaderIntrospection(ShaderProgramInterface::Uniform);
+		}
 
 		return _linkStatus;
 	}
@@ -178,31 +284,376 @@ namespace spl
 		_flags = ShaderProgramFlags::None;
 		_linkStatus = 0;
 
+		_introspectedInterfaces.reset();
 		_interfacesInfos.fill({});
 		_resourcesInfos.fill({});
 		_locations.fill({});
-		_locationIndices.fill({});
+
+		_uniformShadow.clear();
+		_uniformShadowOffsets.clear();
+		_uniformShadowInitialized.clear();
+		_uniformCacheHitCount = 0;
+		_uniformCacheMissCount = 0;
+
+		_subroutineSelections.fill({});
+
+		_computeWorkGroupSize = { 0, 0, 0 };
 	}
 
 	const ShaderProgramInterfaceInfos& ShaderProgram::getInterfaceInfos(ShaderProgramInterface programInterface) const
 	{
 		assert(isValid());
 
+		_shaderIntrospection(programInterface);
+
 		return _interfacesInfos[static_cast<uint8_t>(programInterface)];
 	}
 
 	const ShaderProgramResourceInfos& ShaderProgram::getResourceInfos(ShaderProgramInterface programInterface, uint32_t index) const
 	{
 		assert(isValid());
+
+		_shaderIntrospection(programInterface);
+
 		assert(index < _interfacesInfos[static_cast<uint8_t>(programInterface)].activeResources);
 
 		return _resourcesInfos[static_cast<uint8_t>(programInterface)][index];
 	}
 
+	namespace
+	{
+		template<typename T>
+		void writeValue(std::vector<uint8_t>& data, const T& value)
+		{
+			const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+			data.insert(data.end(), bytes, bytes + sizeof(T));
+		}
+
+		template<typename T>
+		void writeArray(std::vector<uint8_t>& data, const T* values, uint32_t count)
+		{
+			writeValue(data, count);
+
+			const uint8_t* bytes = reinterpret_cast<const uint8_t*>(values);
+			data.insert(data.end(), bytes, bytes + count * sizeof(T));
+		}
+
+		template<typename T>
+		bool readValue(const uint8_t*& it, const uint8_t* end, T& value)
+		{
+			if (end - it < sizeof(T))
+			{
+				return false;
+			}
+
+			std::copy_n(it, sizeof(T), reinterpret_cast<uint8_t*>(&value));
+			it += sizeof(T);
+
+			return true;
+		}
+
+		template<typename TContainer>
+		bool readArray(const uint8_t*& it, const uint8_t* end, TContainer& values)
+		{
+			uint32_t count;
+			if (!readValue(it, end, count) || (end - it) / sizeof(typename TContainer::value_type) < count)
+			{
+				return false;
+			}
+
+			values.resize(count);
+			std::copy_n(it, count * sizeof(typename TContainer::value_type), reinterpret_cast<uint8_t*>(values.data()));
+			it += count * sizeof(typename TContainer::value_type);
+
+			return true;
+		}
+	}
+
+	void ShaderProgram::serializeIntrospection(std::vector<uint8_t>& data, uint64_t key) const
+	{
+		assert(isValid());
+
+		// Header: magic, version, key and hash of the payload
+
+		data.clear();
+		writeValue(data, _introspectionMagic);
+		writeValue(data, _introspectionVersion);
+		writeValue(data, key);
+		writeValue(data, uint64_t(0));
+
+		const uint64_t headerSize = data.size();
+
+		for (uint8_t i = 0; i < _interfaceCount; ++i)
+		{
+			_shaderIntrospection(static_cast<ShaderProgramInterface>(i));
+
+			// Field by field, so that the data does not depend on the layout (and padding) of the structures
+
+			writeValue(data, _interfacesInfos[i].activeResources);
+			writeValue(data, _interfacesInfos[i].maxNameLength);
+			writeValue(data, _interfacesInfos[i].maxNumActiveVariables);
+			writeValue(data, _interfacesInfos[i].maxNumCompatibleSubroutines);
+
+			writeValue(data, static_cast<uint32_t>(_resourcesInfos[i].size()));
+			for (const ShaderProgramResourceInfos& infos : _resourcesInfos[i])
+			{
+				writeArray(data, infos.name.data(), infos.name.size());
+				writeValue(data, static_cast<uint32_t>(infos.type));
+				writeValue(data, static_cast<uint32_t>(infos.referencedBy));
+				writeValue(data, infos.arraySize);
+				writeValue(data, infos.arrayStride);
+				writeValue(data, static_cast<uint8_t>(infos.isRowMajor));
+				writeValue(data, infos.matrixStride);
+				writeValue(data, infos.bufferBinding);
+				writeValue(data, infos.blockIndex);
+				writeValue(data, infos.atomicCounterBufferIndex);
+				writeValue(data, infos.offset);
+				writeValue(data, infos.topLevelArraySize);
+				writeValue(data, infos.topLevelArrayStride);
+				writeValue(data, infos.transformFeedbackBufferIndex);
+				writeValue(data, infos.transformFeedbackBufferStride);
+				writeArray(data, infos.activeVariables.data(), infos.activeVariables.size());
+				writeArray(data, infos.compatibleSubroutines.data(), infos.compatibleSubroutines.size());
+				writeValue(data, infos.bufferDataSize);
+				writeValue(data, infos.locationComponent);
+				writeValue(data, static_cast<uint8_t>(infos.isPerPatch));
+			}
+
+			writeValue(data, static_cast<uint32_t>(_locations[i].size()));
+			for (const ShaderProgramResourceLocation& resourceLocation : _locations[i])
+			{
+				writeValue(data, resourceLocation.nameHash);
+				writeValue(data, resourceLocation.resourceIndex);
+				writeValue(data, resourceLocation.arrayElement);
+				writeValue(data, resourceLocation.location);
+				writeValue(data, resourceLocation.locationIndex);
+			}
+		}
+
+		const uint64_t payloadHash = _spl::fnv1a(reinterpret_cast<const char*>(data.data() + headerSize), data.size() - headerSize);
+		std::copy_n(reinterpret_cast<const uint8_t*>(&payloadHash), sizeof(uint64_t), data.data() + headerSize - sizeof(uint64_t));
+	}
+
+	bool ShaderProgram::deserializeIntrospection(const void* data, uint64_t size, uint64_t key)
+	{
+		assert(isValid());
+		assert(!(_flags & ShaderProgramFlags::NoIntrospection));
+
+		const uint8_t* it = reinterpret_cast<const uint8_t*>(data);
+		const uint8_t* end = it + size;
+
+		uint32_t magic, version;
+		uint64_t dataKey, payloadHash;
+		if (!readValue(it, end, magic) || !readValue(it, end, version) || !readValue(it, end, dataKey) || !readValue(it, end, payloadHash)
+			|| magic != _introspectionMagic || version != _introspectionVersion || dataKey != key
+			|| payloadHash != _spl::fnv1a(reinterpret_cast<const char*>(it), end - it))
+		{
+			return false;
+		}
+
+		std::array<ShaderProgramInterfaceInfos, _interfaceCount> interfacesInfos;
+		std::array<std::vector<ShaderProgramResourceInfos>, _interfaceCount> resourcesInfos;
+		std::array<std::vector<ShaderProgramResourceLocation>, _interfaceCount> locations;
+
+		for (uint8_t i = 0; i < _interfaceCount; ++i)
+		{
+			uint32_t resourceCount;
+			if (!readValue(it, end, interfacesInfos[i].activeResources)
+				|| !readValue(it, end, interfacesInfos[i].maxNameLength)
+				|| !readValue(it, end, interfacesInfos[i].maxNumActiveVariables)
+				|| !readValue(it, end, interfacesInfos[i].maxNumCompatibleSubroutines)
+				|| !readValue(it, end, resourceCount))
+			{
+				return false;
+			}
+
+			resourcesInfos[i].resize(std::min<uint64_t>(resourceCount, end - it));
+			for (ShaderProgramResourceInfos& infos : resourcesInfos[i])
+			{
+				uint32_t type, referencedBy;
+				uint8_t isRowMajor, isPerPatch;
+
+				if (!readArray(it, end, infos.name)
+					|| !readValue(it, end, type)
+					|| !readValue(it, end, referencedBy)
+					|| !readValue(it, end, infos.arraySize)
+					|| !readValue(it, end, infos.arrayStride)
+					|| !readValue(it, end, isRowMajor)
+					|| !readValue(it, end, infos.matrixStride)
+					|| !readValue(it, end, infos.bufferBinding)
+					|| !readValue(it, end, infos.blockIndex)
+					|| !readValue(it, end, infos.atomicCounterBufferIndex)
+					|| !readValue(it, end, infos.offset)
+					|| !readValue(it, end, infos.topLevelArraySize)
+					|| !readValue(it, end, infos.topLevelArrayStride)
+					|| !readValue(it, end, infos.transformFeedbackBufferIndex)
+					|| !readValue(it, end, infos.transformFeedbackBufferStride)
+					|| !readArray(it, end, infos.activeVariables)
+					|| !readArray(it, end, infos.compatibleSubroutines)
+					|| !readValue(it, end, infos.bufferDataSize)
+					|| !readValue(it, end, infos.locationComponent)
+					|| !readValue(it, end, isPerPatch))
+				{
+					return false;
+				}
+
+				infos.type = static_cast<GlslType>(type);
+				infos.referencedBy = static_cast<ShaderStage::Stage>(referencedBy);
+				infos.isRowMajor = isRowMajor;
+				infos.isPerPatch = isPerPatch;
+			}
+
+			if (resourcesInfos[i].size() != resourceCount)
+			{
+				return false;
+			}
+
+			uint32_t locationCount;
+			if (!readValue(it, end, locationCount) || (end - it) / (sizeof(uint64_t) + 4 * sizeof(uint32_t)) < locationCount || (locationCount & (locationCount - 1)) != 0)
+			{
+				return false;
+			}
+
+			locations[i].resize(locationCount);
+			for (ShaderProgramResourceLocation& resourceLocation : locations[i])
+			{
+				readValue(it, end, resourceLocation.nameHash);
+				readValue(it, end, resourceLocation.resourceIndex);
+				readValue(it, end, resourceLocation.arrayElement);
+				readValue(it, end, resourceLocation.location);
+				readValue(it, end, resourceLocation.locationIndex);
+			}
+		}
+
+		if (it != end)
+		{
+			return false;
+		}
+
+		_interfacesInfos = std::move(interfacesInfos);
+		_resourcesInfos = std::move(resourcesInfos);
+		_locations = std::move(locations);
+		_introspectedInterfaces.set();
+
+		_uniformShadow.clear();
+		_uniformShadowOffsets.clear();
+		_uniformShadowInitialized.clear();
+		_createUniformShadow();
+
+		return true;
+	}
+
+	UniformHandle ShaderProgram::getUniformHandle(const std::string& name) const
+	{
+		// Without introspection, nothing is known about the uniform but its location (unless uniforms were already
+		// introspected for a lookup by Name)
+
+		if ((_flags & ShaderProgramFlags::NoIntrospection) && !_introspectedInterfaces[static_cast<uint8_t>(ShaderProgramInterface::Uniform)])
+		{
+			assert(isValid());
+
+			UniformHandle handle;
+			handle.location = glGetProgramResourceLocation(_program, GL_UNIFORM, name.c_str());
+			handle.arraySize = -1;
+
+			return handle;
+		}
+
+		return getUniformHandle(Name(name));
+	}
+
+	UniformHandle ShaderProgram::getUniformHandle(Name name) const
+	{
+		assert(isValid());
+
+		_shaderIntrospection(ShaderProgramInterface::Uniform);
+
+		const ShaderProgramResourceLocation* resourceLocation = _findResourceLocation(ShaderProgramInterface::Uniform, name.hash);
+		if (!resourceLocation)
+		{
+			return {};
+		}
+
+		const ShaderProgramResourceInfos& infos = _resourcesInfos[static_cast<uint8_t>(ShaderProgramInterface::Uniform)][resourceLocation->resourceIndex];
+
+		UniformHandle handle;
+		handle.location = resourceLocation->location;
+		handle.type = infos.type;
+		handle.arraySize = infos.arraySize - resourceLocation->arrayElement;
+
+		return handle;
+	}
+
 	void ShaderProgram::setUniform(const std::string& name, uint32_t textureUnit, const Texture* texture) const
+	{
+		setUniform(getUniformHandle(name), textureUnit, texture);
+	}
+
+	void ShaderProgram::setUniform(Name name, uint32_t textureUnit, const Texture* texture) const
+	{
+		setUniform(getUniformHandle(name), textureUnit, texture);
+	}
+
+	void ShaderProgram::setUniform(const UniformHandle& handle, uint32_t textureUnit, const Texture* texture) const
 	{
 		Texture::bind(texture, textureUnit);
-		_setUniform(name, GlslType::Int, &textureUnit, 1);
+		_setUniform(handle, GlslType::Int, &textureUnit, 1);
+	}
+
+	void ShaderProgram::setUniform(const std::string& name, uint32_t imageUnit, const Texture* texture, ImageAccess access, TextureInternalFormat format) const
+	{
+		setUniform(getUniformHandle(name), imageUnit, texture, access, format);
+	}
+
+	void ShaderProgram::setUniform(Name name, uint32_t imageUnit, const Texture* texture, ImageAccess access, TextureInternalFormat format) const
+	{
+		setUniform(getUniformHandle(name), imageUnit, texture, access, format);
+	}
+
+	void ShaderProgram::setUniform(const UniformHandle& handle, uint32_t imageUnit, const Texture* texture, ImageAccess access, TextureInternalFormat format) const
+	{
+		assert(handle.type == GlslType::Undefined || (handle.type >= GlslType::Image1d && handle.type <= GlslType::UnsignedIntImage2dMultisampleArray));
+
+		Texture::bindImage(texture, imageUnit, access, format);
+		_setUniform(handle, GlslType::Int, &imageUnit, 1);
+	}
+
+	void ShaderProgram::setSubroutine(ShaderStage::Stage stage, const std::string& subroutineUniform, const std::string& subroutine) const
+	{
+		const Name subroutineUniformName(subroutineUniform);
+		const Name subroutineName(subroutine);
+		setSubroutines(stage, &subroutineUniformName, &subroutineName, 1);
+	}
+
+	void ShaderProgram::setSubroutine(ShaderStage::Stage stage, Name subroutineUniform, Name subroutine) const
+	{
+		setSubroutines(stage, &subroutineUniform, &subroutine, 1);
+	}
+
+	void ShaderProgram::setSubroutines(ShaderStage::Stage stage, const Name* subroutineUniforms, const Name* subroutines, uint32_t count) const
+	{
+		assert(isValid());
+		assert(std::has_single_bit(static_cast<uint32_t>(stage)));
+
+		const uint8_t stageIndex = std::countr_zero(static_cast<uint32_t>(stage));
+
+		bool changed = false;
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			changed |= _selectSubroutine(stageIndex, subroutineUniforms[i], subroutines[i]);
+		}
+
+		// Every subroutine uniform of the stage is set in a single call, and only if the selection changed. The
+		// program is either bound or the program of this stage in the bound pipeline.
+
+		const Context* context = Context::getCurrentContext();
+		const ShaderPipeline* pipeline = context->getShaderPipelineBinding();
+		const bool isActive = (context->getShaderBinding() == this) || (!context->getShaderBinding() && pipeline && pipeline->getStageProgram(stage) == this);
+
+		if (changed && isActive)
+		{
+			_applySubroutines(stageIndex);
+		}
 	}
 
 	void ShaderProgram::setUniformBlockBinding(uint32_t shaderBindingIndex, uint32_t bufferBindingIndex) const
@@ -221,6 +672,66 @@ namespace spl
 		glShaderStorageBlockBinding(_program, shaderBindingIndex, bufferBindingIndex);
 	}
 
+	void ShaderProgram::dispatch(const scp::u32vec3& groups) const
+	{
+		assert(isValid());
+
+		Context* context = Context::getCurrentContext();
+
+		const ImplementationDependent::ComputeShaderLimits& limits = context->getImplementationDependentValues().computeShader;
+		assert(getComputeWorkGroupSize().x != 0);
+		assert(groups.x <= limits.maxComputeWorkGroupCount.x);
+		assert(groups.y <= limits.maxComputeWorkGroupCount.y);
+		assert(groups.z <= limits.maxComputeWorkGroupCount.z);
+
+		if (context->getShaderBinding() != this)
+		{
+			bind(this);
+		}
+
+		context->_prepareShaderInvocation(nullptr, false, nullptr);
+		glDispatchCompute(groups.x, groups.y, groups.z);
+		context->_recordShaderWrites();
+	}
+
+	void ShaderProgram::dispatchIndirect(const Buffer& buffer, uintptr_t offset) const
+	{
+		assert(isValid());
+		assert(buffer.isValid());
+		assert(offset % 4 == 0);
+		assert(offset + 3 * sizeof(uint32_t) <= buffer.getSize());
+		assert(getComputeWorkGroupSize().x != 0);
+
+		Context* context = Context::getCurrentContext();
+
+		if (context->getShaderBinding() != this)
+		{
+			bind(this);
+		}
+
+		if (context->getBufferBinding(BufferTarget::DispatchIndirect) != &buffer)
+		{
+			Buffer::bind(BufferTarget::DispatchIndirect, &buffer);
+		}
+
+		context->_prepareShaderInvocation(nullptr, false, &buffer);
+		glDispatchComputeIndirect(offset);
+		context->_recordShaderWrites();
+	}
+
+	scp::u32vec3 ShaderProgram::computeGroupCount(const scp::u32vec3& invocations) const
+	{
+		const scp::u32vec3& groupSize = getComputeWorkGroupSize();
+
+		assert(groupSize.x != 0);
+
+		return {
+			(invocations.x + groupSize.x - 1) / groupSize.x,
+			(invocations.y + groupSize.y - 1) / groupSize.y,
+			(invocations.z + groupSize.z - 1) / groupSize.z
+		};
+	}
+
 	uint32_t ShaderProgram::getHandle() const
 	{
 		return _program;
@@ -231,9 +742,39 @@ namespace spl
 		return _flags;
 	}
 
+	const scp::u32vec3& ShaderProgram::getComputeWorkGroupSize() const
+	{
+		assert(isValid());
+
+		// Only programs with a compute stage have a work group size
+
+		if (_computeWorkGroupSize.x == 0)
+		{
+			glGetProgramiv(_program, GL_COMPUTE_WORK_GROUP_SIZE, reinterpret_cast<int32_t*>(&_computeWorkGroupSize));
+
+			const ImplementationDependent::ComputeShaderLimits& limits = Context::getCurrentContext()->getImplementationDependentValues().computeShader;
+			assert(_computeWorkGroupSize.x <= limits.maxComputeWorkGroupSize.x);
+			assert(_computeWorkGroupSize.y <= limits.maxComputeWorkGroupSize.y);
+			assert(_computeWorkGroupSize.z <= limits.maxComputeWorkGroupSize.z);
+			assert(_computeWorkGroupSize.x * _computeWorkGroupSize.y * _computeWorkGroupSize.z <= limits.maxComputeWorkGroupInvocations);
+		}
+
+		return _computeWorkGroupSize;
+	}
+
+	uint64_t ShaderProgram::getUniformCacheHitCount() const
+	{
+		return _uniformCacheHitCount;
+	}
+
+	uint64_t ShaderProgram::getUniformCacheMissCount() const
+	{
+		return _uniformCacheMissCount;
+	}
+
 	bool ShaderProgram::isValid() const
 	{
-		return _program != 0 && _linkStatus != 0;
+		return _program != 0 && _linkStatus > 0;
 	}
 
 	ShaderProgram::~ShaderProgram()
@@ -250,10 +791,26 @@ namespace spl
 		if (program)
 		{
 			glUseProgram(program->_program);
+
+			for (uint8_t i = 0; i < _stageCount; ++i)
+			{
+				if (!program->_subroutineSelections[i].empty())
+				{
+					program->_applySubroutines(i);
+				}
+			}
 		}
 		else
 		{
 			glUseProgram(0);
+
+			// The bound pipeline is used again, with its subroutine uniforms reset
+
+			const ShaderPipeline* pipeline = Context::getCurrentContext()->getShaderPipelineBinding();
+			if (pipeline)
+			{
+				pipeline->_applySubroutines();
+			}
 		}
 	}
 
@@ -644,27 +1201,63 @@ namespace spl
 			}
 		}
 
+		void insertResourceLocation(std::vector<ShaderProgramResourceLocation>* locations, const ShaderProgramResourceLocation& resourceLocation)
+		{
+			// Linear probing, the table is sized beforehand so that it is at most half full
+
+			const uint64_t mask = locations->size() - 1;
+
+			uint64_t i = resourceLocation.nameHash & mask;
+			while ((*locations)[i].resourceIndex != -1 && (*locations)[i].nameHash != resourceLocation.nameHash)
+			{
+				i = (i + 1) & mask;
+			}
+
+			(*locations)[i] = resourceLocation;
+		}
+
 		template<uint8_t Interface>
-		inline void extractResourceLocation(uint32_t program, std::unordered_map<std::string, uint32_t>* locations, std::unordered_map<std::string, uint32_t>* locationIndices, const char* name)
+		inline void extractResourceLocation(uint32_t program, std::vector<ShaderProgramResourceLocation>* locations, const char* name, uint32_t resourceIndex, uint32_t arrayElement)
 		{
 			static constexpr GLenum glInterface = _spl::shaderProgramInterfaceToGLenum(static_cast<ShaderProgramInterface>(Interface));
 
-			(*locations)[name] = glGetProgramResourceLocation(program, glInterface, name);
+			ShaderProgramResourceLocation resourceLocation;
+			resourceLocation.nameHash = Name(name).hash;
+			resourceLocation.resourceIndex = resourceIndex;
+			resourceLocation.arrayElement = arrayElement;
+
+			if constexpr (glInterface != GL_COMPUTE_SUBROUTINE
+				&& glInterface != GL_VERTEX_SUBROUTINE
+				&& glInterface != GL_TESS_CONTROL_SUBROUTINE
+				&& glInterface != GL_TESS_EVALUATION_SUBROUTINE
+				&& glInterface != GL_GEOMETRY_SUBROUTINE
+				&& glInterface != GL_FRAGMENT_SUBROUTINE)
+			{
+				resourceLocation.location = glGetProgramResourceLocation(program, glInterface, name);
+			}
 
 			if constexpr (glInterface == GL_PROGRAM_OUTPUT)
 			{
-				(*locationIndices)[name] = glGetProgramResourceLocationIndex(program, glInterface, name);
+				resourceLocation.locationIndex = glGetProgramResourceLocationIndex(program, glInterface, name);
 			}
+
+			insertResourceLocation(locations, resourceLocation);
 		}
 
 		template<uint8_t Interface>
-		inline void extractResourcesLocation(uint32_t program, const std::vector<ShaderProgramResourceInfos>* resourcesInfos, std::unordered_map<std::string, uint32_t>* locations, std::unordered_map<std::string, uint32_t>* locationIndices)
+		inline void extractResourcesLocation(uint32_t program, const std::vector<ShaderProgramResourceInfos>* resourcesInfos, std::vector<ShaderProgramResourceLocation>* locations)
 		{
 			static constexpr GLenum glInterface = _spl::shaderProgramInterfaceToGLenum(static_cast<ShaderProgramInterface>(Interface));
 
 			if constexpr (glInterface == GL_UNIFORM
 				|| glInterface == GL_PROGRAM_INPUT
 				|| glInterface == GL_PROGRAM_OUTPUT
+				|| glInterface == GL_COMPUTE_SUBROUTINE
+				|| glInterface == GL_VERTEX_SUBROUTINE
+				|| glInterface == GL_TESS_CONTROL_SUBROUTINE
+				|| glInterface == GL_TESS_EVALUATION_SUBROUTINE
+				|| glInterface == GL_GEOMETRY_SUBROUTINE
+				|| glInterface == GL_FRAGMENT_SUBROUTINE
 				|| glInterface == GL_COMPUTE_SUBROUTINE_UNIFORM
 				|| glInterface == GL_VERTEX_SUBROUTINE_UNIFORM
 				|| glInterface == GL_TESS_CONTROL_SUBROUTINE_UNIFORM
@@ -672,9 +1265,32 @@ namespace spl
 				|| glInterface == GL_GEOMETRY_SUBROUTINE_UNIFORM
 				|| glInterface == GL_FRAGMENT_SUBROUTINE_UNIFORM)
 			{
-				for (const ShaderProgramResourceInfos infos : *resourcesInfos)
+				// Arrays are accessible as "name", "name[0]", "name[1]"... Subroutines have no location, their resource
+				// index is the subroutine index.
+
+				uint64_t nameCount = 0;
+				for (const ShaderProgramResourceInfos& infos : *resourcesInfos)
+				{
+					nameCount += infos.name.ends_with("[0]") ? infos.arraySize + 1 : 1;
+				}
+
+				if (nameCount == 0)
+				{
+					return;
+				}
+
+				uint64_t capacity = 1;
+				while (capacity < 2 * nameCount)
 				{
-					extractResourceLocation<Interface>(program, locations, locationIndices, infos.name.c_str());
+					capacity <<= 1;
+				}
+				locations->resize(capacity);
+
+				for (uint32_t index = 0; index < resourcesInfos->size(); ++index)
+				{
+					const ShaderProgramResourceInfos& infos = (*resourcesInfos)[index];
+
+					extractResourceLocation<Interface>(program, locations, infos.name.c_str(), index, 0);
 
 					if (infos.name.ends_with("[0]"))
 					{
@@ -685,7 +1301,7 @@ namespace spl
 						std::copy_n(infos.name.data(), rootSize, buffer);
 						std::fill_n(buffer + rootSize, bufferSize - rootSize, '\0');
 
-						extractResourceLocation<Interface>(program, locations, locationIndices, buffer);
+						extractResourceLocation<Interface>(program, locations, buffer, index, 0);
 
 						*(buffer + rootSize) = '[';
 						char* beginNum = buffer + rootSize + 1;
@@ -693,7 +1309,7 @@ namespace spl
 						for (uint32_t i = 1; i < infos.arraySize; ++i)
 						{
 							*std::to_chars(beginNum, endNum, i).ptr = ']';
-							extractResourceLocation<Interface>(program, locations, locationIndices, buffer);
+							extractResourceLocation<Interface>(program, locations, buffer, index, i);
 						}
 					}
 				}
@@ -701,31 +1317,170 @@ namespace spl
 		}
 
 		template<uint8_t Interface>
-		inline void extractInfos(uint32_t program, ShaderProgramInterfaceInfos* interfaceInfos, std::vector<ShaderProgramResourceInfos>* resourcesInfos, std::unordered_map<std::string, uint32_t>* locations, std::unordered_map<std::string, uint32_t>* locationIndices)
+		void extractInfos(uint32_t program, ShaderProgramInterfaceInfos* interfaceInfos, std::vector<ShaderProgramResourceInfos>* resourcesInfos, std::vector<ShaderProgramResourceLocation>* locations)
 		{
 			extractInterfaceInfos<Interface>(program, interfaceInfos);
 			extractResourcesInfos<Interface>(program, interfaceInfos->activeResources, resourcesInfos);
-			extractResourcesLocation<Interface>(program, resourcesInfos, locations, locationIndices);
+			extractResourcesLocation<Interface>(program, resourcesInfos, locations);
+		}
+
+		using ExtractInfosFunc = void(*)(uint32_t, ShaderProgramInterfaceInfos*, std::vector<ShaderProgramResourceInfos>*, std::vector<ShaderProgramResourceLocation>*);
+
+		template<uint8_t... Interfaces>
+		consteval std::array<ExtractInfosFunc, sizeof...(Interfaces)> createExtractInfosTable(std::integer_sequence<uint8_t, Interfaces...>)
+		{
+			return { &extractInfos<Interfaces>... };
+		}
+	}
+
+	void ShaderProgram::_shaderIntrospection(ShaderProgramInterface programInterface) const
+	{
+		// Lookups by Name only have a hash and need the uniform table, even with NoIntrospection. It is then built on
+		// the first of these lookups.
+
+		assert(!(_flags & ShaderProgramFlags::NoIntrospection) || programInterface == ShaderProgramInterface::Uniform);
 
-			if constexpr (Interface != 0)
+		static constexpr std::array<ExtractInfosFunc, _interfaceCount> extractInfosTable = createExtractInfosTable(std::make_integer_sequence<uint8_t, _interfaceCount>());
+
+		const uint8_t index = static_cast<uint8_t>(programInterface);
+		if (_introspectedInterfaces[index])
+		{
+			return;
+		}
+
+		extractInfosTable[index](_program, &_interfacesInfos[index], &_resourcesInfos[index], &_locations[index]);
+		_introspectedInterfaces[index] = true;
+
+		if (programInterface == ShaderProgramInterface::Uniform)
+		{
+			_createUniformShadow();
+		}
+	}
+
+	const ShaderProgramResourceLocation* ShaderProgram::_findResourceLocation(ShaderProgramInterface programInterface, uint64_t nameHash) const
+	{
+		const std::vector<ShaderProgramResourceLocation>& locations = _locations[static_cast<uint8_t>(programInterface)];
+		if (locations.empty())
+		{
+			return nullptr;
+		}
+
+		const uint64_t mask = locations.size() - 1;
+		for (uint64_t i = nameHash & mask; locations[i].resourceIndex != -1; i = (i + 1) & mask)
+		{
+			if (locations[i].nameHash == nameHash)
 			{
-				extractInfos<Interface - 1>(program, interfaceInfos - 1, resourcesInfos - 1, locations - 1, locationIndices - 1);
+				return &locations[i];
 			}
 		}
+
+		return nullptr;
 	}
 
-	void ShaderProgram::_shaderIntrospection()
+	void ShaderProgram::_swap(ShaderProgram& program)
 	{
-		extractInfos<_interfaceCount - 1>(_program, &_interfacesInfos.back(), &_resourcesInfos.back(), &_locations.back(), &_locationIndices.back());
+		std::swap(_program, program._program);
+		std::swap(_flags, program._flags);
+		std::swap(_linkStatus, program._linkStatus);
+
+		std::swap(_introspectedInterfaces, program._introspectedInterfaces);
+		std::swap(_interfacesInfos, program._interfacesInfos);
+		std::swap(_resourcesInfos, program._resourcesInfos);
+		std::swap(_locations, program._locations);
+
+		std::swap(_uniformShadow, program._uniformShadow);
+		std::swap(_uniformShadowOffsets, program._uniformShadowOffsets);
+		std::swap(_uniformShadowInitialized, program._uniformShadowInitialized);
+		std::swap(_uniformCacheHitCount, program._uniformCacheHitCount);
+		std::swap(_uniformCacheMissCount, program._uniformCacheMissCount);
+
+		std::swap(_subroutineSelections, program._subroutineSelections);
+		std::swap(_computeWorkGroupSize, program._computeWorkGroupSize);
+
+		// The GL programs changed but the bindings did not
+
+		const ShaderProgram* binding = Context::getCurrentContext()->getShaderBinding();
+		if (binding == this || binding == &program)
+		{
+			bind(binding);
+		}
 	}
 
-	void ShaderProgram::_setUniform(const std::string& name, GlslType type, const void* values, uint32_t count) const
+	void ShaderProgram::_createUniformShadow() const
+	{
+		// Uniforms of the default block are the only ones with a location. The initial values (that can be set in GLSL)
+		// are unknown, so each element is uploaded at least once.
+
+		uint32_t shadowSize = 0;
+		for (const ShaderProgramResourceInfos& infos : _resourcesInfos[static_cast<uint8_t>(ShaderProgramInterface::Uniform)])
+		{
+			const ShaderProgramResourceLocation* resourceLocation = _findResourceLocation(ShaderProgramInterface::Uniform, Name(infos.name).hash);
+			if (!resourceLocation || resourceLocation->location == -1)
+			{
+				continue;
+			}
+
+			const uint32_t elementSize = _spl::glslTypeToSize(infos.type);
+			const uint32_t endLocation = resourceLocation->location + std::max(infos.arraySize, 1u);
+			if (_uniformShadowOffsets.size() < endLocation)
+			{
+				_uniformShadowOffsets.resize(endLocation, -1);
+			}
+
+			for (uint32_t location = resourceLocation->location; location < endLocation; ++location, shadowSize += elementSize)
+			{
+				_uniformShadowOffsets[location] = shadowSize;
+			}
+		}
+
+		_uniformShadow.resize(shadowSize);
+		_uniformShadowInitialized.resize(_uniformShadowOffsets.size(), false);
+	}
+
+	void ShaderProgram::_setUniform(const UniformHandle& handle, GlslType type, const void* values, uint32_t count) const
 	{
 		assert(isValid());
-		assert(_locations[static_cast<uint8_t>(ShaderProgramInterface::Uniform)].find(name) != _locations[static_cast<uint8_t>(ShaderProgramInterface::Uniform)].end());
-		// TODO: Check type, array size, etc. corresponds...
+		assert(handle.location != -1);
+		assert(count <= handle.arraySize);
+		// TODO: Check type corresponds...
+
+		int32_t location = handle.location;
+
+		// Only upload the range of elements that differs from the shadow copy
+
+		if (location < _uniformShadowOffsets.size() && _uniformShadowOffsets[location] != -1)
+		{
+			const uint32_t elementSize = _spl::glslTypeToSize(type);
+			const uint8_t* bytes = reinterpret_cast<const uint8_t*>(values);
+			uint8_t* shadow = _uniformShadow.data() + _uniformShadowOffsets[location];
+
+			uint32_t first = 0;
+			while (first < count && _uniformShadowInitialized[location + first] && std::equal(bytes + first * elementSize, bytes + (first + 1) * elementSize, shadow + first * elementSize))
+			{
+				++first;
+			}
+
+			if (first == count)
+			{
+				++_uniformCacheHitCount;
+				return;
+			}
+
+			uint32_t last = count - 1;
+			while (last > first && _uniformShadowInitialized[location + last] && std::equal(bytes + last * elementSize, bytes + (last + 1) * elementSize, shadow + last * elementSize))
+			{
+				--last;
+			}
+
+			++_uniformCacheMissCount;
+
+			std::copy(bytes + first * elementSize, bytes + (last + 1) * elementSize, shadow + first * elementSize);
+			std::fill_n(_uniformShadowInitialized.begin() + location + first, last + 1 - first, true);
 
-		const uint32_t& location = _locations[static_cast<uint8_t>(ShaderProgramInterface::Uniform)].find(name)->second;
+			location += first;
+			values = bytes + first * elementSize;
+			count = last + 1 - first;
+		}
 
 		switch (type)
 		{
@@ -836,4 +1591,161 @@ namespace spl
 				break;
 		}
 	}
+
+	void ShaderProgram::_copyUniformValues(const ShaderProgram& program) const
+	{
+		// Uniforms are matched by name and type. Only the elements set in "program" are known, from its shadow copy.
+
+		program._shaderIntrospection(ShaderProgramInterface::Uniform);
+
+		for (const ShaderProgramResourceInfos& infos : program._resourcesInfos[static_cast<uint8_t>(ShaderProgramInterface::Uniform)])
+		{
+			const ShaderProgramResourceLocation* resourceLocation = program._findResourceLocation(ShaderProgramInterface::Uniform, Name(infos.name).hash);
+			if (!resourceLocation || resourceLocation->location == -1 || resourceLocation->location >= program._uniformShadowOffsets.size())
+			{
+				continue;
+			}
+
+			UniformHandle handle = getUniformHandle(Name(infos.name));
+			if (handle.location == -1 || handle.type != infos.type)
+			{
+				continue;
+			}
+
+			const GlslType type = glslTypeToUploadType(infos.type);
+			const uint32_t count = std::min(std::max(infos.arraySize, 1u), std::max(handle.arraySize, 1u));
+			for (uint32_t i = 0; i < count; ++i, ++handle.location)
+			{
+				const uint32_t location = resourceLocation->location + i;
+				if (program._uniformShadowInitialized[location])
+				{
+					_setUniform(handle, type, program._uniformShadow.data() + program._uniformShadowOffsets[location], 1);
+				}
+			}
+		}
+	}
+
+	bool ShaderProgram::_selectSubroutine(uint8_t stageIndex, Name subroutineUniform, Name subroutine) const
+	{
+		const ShaderProgramInterface subroutineInterface = static_cast<ShaderProgramInterface>(static_cast<uint8_t>(ShaderProgramInterface::ComputeSubroutine) + stageIndex);
+		const ShaderProgramInterface uniformInterface = static_cast<ShaderProgramInterface>(static_cast<uint8_t>(ShaderProgramInterface::ComputeSubroutineUniform) + stageIndex);
+
+		_shaderIntrospection(subroutineInterface);
+		_shaderIntrospection(uniformInterface);
+
+		const std::vector<ShaderProgramResourceInfos>& uniformsInfos = _resourcesInfos[static_cast<uint8_t>(uniformInterface)];
+
+		std::vector<uint32_t>& selection = _subroutineSelections[stageIndex];
+
+		if (selection.empty())
+		{
+			_createDefaultSubroutineSelection(stageIndex);
+		}
+
+		const ShaderProgramResourceLocation* uniformLocation = _findResourceLocation(uniformInterface, subroutineUniform.hash);
+		const ShaderProgramResourceLocation* subroutineLocation = _findResourceLocation(subroutineInterface, subroutine.hash);
+
+		assert(uniformLocation && uniformLocation->location < selection.size());
+		assert(subroutineLocation);
+		assert(std::ranges::find(uniformsInfos[uniformLocation->resourceIndex].compatibleSubroutines, subroutineLocation->resourceIndex) != uniformsInfos[uniformLocation->resourceIndex].compatibleSubroutines.end());
+
+		if (selection[uniformLocation->location] == subroutineLocation->resourceIndex)
+		{
+			return false;
+		}
+
+		selection[uniformLocation->location] = subroutineLocation->resourceIndex;
+
+		return true;
+	}
+
+	void ShaderProgram::_createDefaultSubroutineSelection(uint8_t stageIndex) const
+	{
+		const ShaderProgramInterface uniformInterface = static_cast<ShaderProgramInterface>(static_cast<uint8_t>(ShaderProgramInterface::ComputeSubroutineUniform) + stageIndex);
+
+		_shaderIntrospection(uniformInterface);
+
+		std::vector<uint32_t>& selection = _subroutineSelections[stageIndex];
+
+		// Every subroutine uniform location must be set at once, start from the first compatible subroutine of each
+
+		int32_t locationCount = 0;
+		glGetProgramStageiv(_program, _spl::shaderStageToGLenum(static_cast<ShaderStage::Stage>(1 << stageIndex)), GL_ACTIVE_SUBROUTINE_UNIFORM_LOCATIONS, &locationCount);
+		selection.assign(locationCount, 0);
+
+		for (const ShaderProgramResourceInfos& infos : _resourcesInfos[static_cast<uint8_t>(uniformInterface)])
+		{
+			const ShaderProgramResourceLocation* resourceLocation = _findResourceLocation(uniformInterface, Name(infos.name).hash);
+			if (resourceLocation && resourceLocation->location != -1 && !infos.compatibleSubroutines.empty())
+			{
+				std::fill_n(selection.begin() + resourceLocation->location, std::max(infos.arraySize, 1u), infos.compatibleSubroutines.front());
+			}
+		}
+	}
+
+	void ShaderProgram::_copySubroutineSelections(const ShaderProgram& program) const
+	{
+		// Subroutine indices may differ between the two programs, so the selections are matched by name
+
+		for (uint8_t stageIndex = 0; stageIndex < _stageCount; ++stageIndex)
+		{
+			const std::vector<uint32_t>& otherSelection = program._subroutineSelections[stageIndex];
+			if (otherSelection.empty())
+			{
+				continue;
+			}
+
+			const ShaderProgramInterface subroutineInterface = static_cast<ShaderProgramInterface>(static_cast<uint8_t>(ShaderProgramInterface::ComputeSubroutine) + stageIndex);
+			const ShaderProgramInterface uniformInterface = static_cast<ShaderProgramInterface>(static_cast<uint8_t>(ShaderProgramInterface::ComputeSubroutineUniform) + stageIndex);
+
+			_shaderIntrospection(subroutineInterface);
+			_shaderIntrospection(uniformInterface);
+
+			const std::vector<ShaderProgramResourceInfos>& otherSubroutinesInfos = program._resourcesInfos[static_cast<uint8_t>(subroutineInterface)];
+			const std::vector<ShaderProgramResourceInfos>& uniformsInfos = _resourcesInfos[static_cast<uint8_t>(uniformInterface)];
+
+			// Uniforms that cannot be matched keep their default subroutine
+
+			std::vector<uint32_t>& selection = _subroutineSelections[stageIndex];
+			_createDefaultSubroutineSelection(stageIndex);
+
+			for (const ShaderProgramResourceInfos& otherInfos : program._resourcesInfos[static_cast<uint8_t>(uniformInterface)])
+			{
+				const uint64_t uniformHash = Name(otherInfos.name).hash;
+				const ShaderProgramResourceLocation* otherLocation = program._findResourceLocation(uniformInterface, uniformHash);
+				const ShaderProgramResourceLocation* uniformLocation = _findResourceLocation(uniformInterface, uniformHash);
+				if (!otherLocation || otherLocation->location == -1 || !uniformLocation || uniformLocation->location == -1)
+				{
+					continue;
+				}
+
+				const std::vector<uint32_t>& compatibleSubroutines = uniformsInfos[uniformLocation->resourceIndex].compatibleSubroutines;
+				const uint32_t count = std::min(std::max(otherInfos.arraySize, 1u), std::max(uniformsInfos[uniformLocation->resourceIndex].arraySize, 1u));
+				for (uint32_t i = 0; i < count; ++i)
+				{
+					const uint32_t otherSubroutine = otherSelection[otherLocation->location + i];
+					if (otherSubroutine >= otherSubroutinesInfos.size())
+					{
+						continue;
+					}
+
+					const uint64_t subroutineHash = Name(otherSubroutinesInfos[otherSubroutine].name).hash;
+					const ShaderProgramResourceLocation* subroutineLocation = _findResourceLocation(subroutineInterface, subroutineHash);
+					if (!subroutineLocation || std::ranges::find(compatibleSubroutines, subroutineLocation->resourceIndex) == compatibleSubroutines.end() || uniformLocation->location + i >= selection.size())
+					{
+						continue;
+					}
+
+					selection[uniformLocation->location + i] = subroutineLocation->resourceIndex;
+				}
+			}
+		}
+	}
+
+	void ShaderProgram::_applySubroutines(uint8_t stageIndex) const
+	{
+		const std::vector<uint32_t>& selection = _subroutineSelections[stageIndex];
+
+		glUniformSubroutinesuiv(_spl::shaderStageToGLenum(static_cast<ShaderStage::Stage>(1 << stageIndex)), selection.size(), selection.data());
+	}
 }
@@ -0,0 +1,328 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2021-2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <SplayLibrary/Core/Core.hpp>
+#include <SplayLibrary/Private/PrivateNotIncluded.hpp>
+
+#if defined(__linux__)
+	#include <poll.h>
+	#include <sys/inotify.h>
+	#include <unistd.h>
+#endif
+
+namespace spl
+{
+	namespace
+	{
+		std::string normalizePath(const std::filesystem::path& path)
+		{
+			std::error_code error;
+			return std::filesystem::absolute(path, error).lexically_normal().string();
+		}
+	}
+
+	ShaderReloader::ShaderReloader() :
+		_preprocessor(),
+		_programs(),
+		_mutex(),
+		_watchedPaths(),
+		_watchedDirectories(),
+		_changedPaths(),
+		_inotify(-1),
+		_stopWatcher(false),
+		_watcherThread()
+	{
+#if defined(__linux__)
+		_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif
+
+		_watcherThread = std::thread(&ShaderReloader::_watcherLoop, this);
+	}
+
+	void ShaderReloader::addIncludeDirectory(const std::filesystem::path& directory)
+	{
+		_preprocessor.addIncludeDirectory(directory);
+	}
+
+	void ShaderReloader::watch(ShaderProgram* program, const ShaderStage::Stage* stages, const std::filesystem::path* glslFiles, uint8_t count, ShaderProgramFlags::Flags flags, const std::map<std::string, std::string>& defines)
+	{
+		assert(program != nullptr);
+		assert(count != 0 && count <= 5);
+
+		unwatch(program);
+
+		WatchedProgram& watchedProgram = _programs.emplace_back();
+		watchedProgram.program = program;
+		watchedProgram.flags = flags;
+		watchedProgram.defines = defines;
+
+		for (uint8_t i = 0; i < count; ++i)
+		{
+			watchedProgram.stages.push_back(stages[i]);
+			watchedProgram.glslFiles.push_back(normalizePath(glslFiles[i]));
+			_watchPath(watchedProgram.glslFiles.back());
+		}
+
+		// The included files are only known once the files are preprocessed
+
+		std::string source;
+		for (uint8_t i = 0; i < count; ++i)
+		{
+			_preprocess(watchedProgram, i, source);
+		}
+	}
+
+	void ShaderReloader::addDependency(const ShaderProgram* program, const std::filesystem::path& path)
+	{
+		WatchedProgram* watchedProgram = _findProgram(program);
+		assert(watchedProgram != nullptr);
+
+		watchedProgram->dependencies.push_back(normalizePath(path));
+		_watchPath(watchedProgram->dependencies.back());
+	}
+
+	void ShaderReloader::unwatch(const ShaderProgram* program)
+	{
+		for (std::vector<WatchedProgram>::iterator it = _programs.begin(); it != _programs.end(); ++it)
+		{
+			if (it->program == program)
+			{
+				_programs.erase(it);
+				return;
+			}
+		}
+	}
+
+	uint32_t ShaderReloader::update()
+	{
+		std::unordered_set<std::string> changedPaths;
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			changedPaths.swap(_changedPaths);
+		}
+
+		uint32_t swapCount = 0;
+		for (WatchedProgram& watchedProgram : _programs)
+		{
+			for (const std::vector<std::string>* paths : { &watchedProgram.glslFiles, &watchedProgram.dependencies, &watchedProgram.includedFiles })
+			{
+				for (const std::string& path : *paths)
+				{
+					watchedProgram.reloadRequested |= changedPaths.contains(path);
+				}
+			}
+
+			// A change during a compilation is handled once this compilation is done
+
+			if (watchedProgram.pendingProgram && watchedProgram.pendingProgram->isLinkingComplete())
+			{
+				for (uint8_t i = 0; i < watchedProgram.stages.size(); ++i)
+				{
+					watchedProgram.pendingModules[i].waitCompilation();
+				}
+
+				if (watchedProgram.pendingProgram->waitLinking())
+				{
+					// The uniform values and subroutine selections of the current program are carried over
+
+					watchedProgram.pendingProgram->_copyUniformValues(*watchedProgram.program);
+					watchedProgram.pendingProgram->_copySubroutineSelections(*watchedProgram.program);
+					watchedProgram.program->_swap(*watchedProgram.pendingProgram);
+					++swapCount;
+				}
+
+				watchedProgram.pendingProgram.reset();
+				watchedProgram.pendingModules.reset();
+			}
+
+			if (watchedProgram.reloadRequested && !watchedProgram.pendingProgram)
+			{
+				_submitReload(watchedProgram);
+			}
+		}
+
+		return swapCount;
+	}
+
+	ShaderReloader::~ShaderReloader()
+	{
+		_stopWatcher = true;
+		_watcherThread.join();
+
+#if defined(__linux__)
+		if (_inotify != -1)
+		{
+			close(_inotify);
+		}
+#endif
+	}
+
+	ShaderReloader::WatchedProgram* ShaderReloader::_findProgram(const ShaderProgram* program)
+	{
+		for (WatchedProgram& watchedProgram : _programs)
+		{
+			if (watchedProgram.program == program)
+			{
+				return &watchedProgram;
+			}
+		}
+
+		return nullptr;
+	}
+
+	void ShaderReloader::_watchPath(const std::string& path)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		if (_watchedPaths.contains(path))
+		{
+			return;
+		}
+
+		std::error_code error;
+		_watchedPaths[path] = std::filesystem::last_write_time(path, error);
+
+#if defined(__linux__)
+		if (_inotify == -1)
+		{
+			return;
+		}
+
+		// Directories are watched rather than files, because editors often replace the file instead of writing it
+
+		const std::string directory = std::filesystem::path(path).parent_path().string();
+		for (const std::pair<const int32_t, std::string>& watchedDirectory : _watchedDirectories)
+		{
+			if (watchedDirectory.second == directory)
+			{
+				return;
+			}
+		}
+
+		const int32_t watchDescriptor = inotify_add_watch(_inotify, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+		if (watchDescriptor != -1)
+		{
+			_watchedDirectories[watchDescriptor] = directory;
+		}
+#endif
+	}
+
+	bool ShaderReloader::_preprocess(WatchedProgram& watchedProgram, uint8_t index, std::string& source)
+	{
+		std::vector<std::filesystem::path> dependencies;
+		if (!_preprocessor.preprocess(watchedProgram.glslFiles[index], watchedProgram.defines, source, &dependencies))
+		{
+			return false;
+		}
+
+		// Includes added since the last reload are watched from now on
+
+		for (const std::filesystem::path& dependency : dependencies)
+		{
+			const std::string path = normalizePath(dependency);
+			if (std::ranges::find(watchedProgram.glslFiles, path) == watchedProgram.glslFiles.end() && std::ranges::find(watchedProgram.includedFiles, path) == watchedProgram.includedFiles.end())
+			{
+				watchedProgram.includedFiles.push_back(path);
+				_watchPath(path);
+			}
+		}
+
+		return true;
+	}
+
+	void ShaderReloader::_submitReload(WatchedProgram& watchedProgram)
+	{
+		const uint8_t count = watchedProgram.stages.size();
+
+		// The file may be missing while an editor is saving it: the reload is then done at the next change
+
+		watchedProgram.reloadRequested = false;
+		watchedProgram.pendingModules = std::make_unique<ShaderModule[]>(count);
+
+		const ShaderModule* moduleArray[5];
+		for (uint8_t i = 0; i < count; ++i)
+		{
+			std::string source;
+			if (!_preprocess(watchedProgram, i, source))
+			{
+				watchedProgram.pendingModules.reset();
+				return;
+			}
+
+			watchedProgram.pendingModules[i].createFromGlslAsync(watchedProgram.stages[i], source.data(), source.size());
+
+			moduleArray[i] = &watchedProgram.pendingModules[i];
+		}
+
+		watchedProgram.pendingProgram = std::make_unique<ShaderProgram>();
+		watchedProgram.pendingProgram->createFromShaderModulesAsync(moduleArray, count, watchedProgram.flags);
+	}
+
+	void ShaderReloader::_watcherLoop()
+	{
+#if defined(__linux__)
+		if (_inotify != -1)
+		{
+			alignas(inotify_event) char buffer[4096];
+
+			while (!_stopWatcher)
+			{
+				pollfd fd = { _inotify, POLLIN, 0 };
+				if (poll(&fd, 1, 100) <= 0)
+				{
+					continue;
+				}
+
+				const ssize_t length = read(_inotify, buffer, sizeof(buffer));
+				if (length <= 0)
+				{
+					continue;
+				}
+
+				std::lock_guard<std::mutex> lock(_mutex);
+				for (const char* it = buffer; it < buffer + length; )
+				{
+					const inotify_event* event = reinterpret_cast<const inotify_event*>(it);
+
+					const std::unordered_map<int32_t, std::string>::const_iterator directoryIt = _watchedDirectories.find(event->wd);
+					if (event->len != 0 && directoryIt != _watchedDirectories.end())
+					{
+						const std::string path = (std::filesystem::path(directoryIt->second) / event->name).string();
+						if (_watchedPaths.contains(path))
+						{
+							_changedPaths.insert(path);
+						}
+					}
+
+					it += sizeof(inotify_event) + event->len;
+				}
+			}
+
+			return;
+		}
+#endif
+
+		// Fallback: poll the modification time of the files
+
+		while (!_stopWatcher)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(250));
+
+			std::lock_guard<std::mutex> lock(_mutex);
+			for (std::pair<const std::string, std::filesystem::file_time_type>& watchedPath : _watchedPaths)
+			{
+				std::error_code error;
+				const std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(watchedPath.first, error);
+				if (!error && writeTime != watchedPath.second)
+				{
+					watchedPath.second = writeTime;
+					_changedPaths.insert(watchedPath.first);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,397 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2021-2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <SplayLibrary/Core/Core.hpp>
+#include <SplayLibrary/Private/PrivateNotIncluded.hpp>
+
+namespace spl
+{
+	namespace
+	{
+		std::string scalarToLiteral(GlslType type, const void* value)
+		{
+			switch (type)
+			{
+				case GlslType::Bool:
+					return *reinterpret_cast<const bool*>(value) ? "true" : "false";
+				case GlslType::Int:
+					return std::to_string(*reinterpret_cast<const int32_t*>(value));
+				case GlslType::UnsignedInt:
+					return std::to_string(*reinterpret_cast<const uint32_t*>(value)) + "u";
+				case GlslType::Float:
+				case GlslType::Double:
+				{
+					// Shortest representation that gives back the same value. NaN and infinities have no literal.
+
+					char buffer[32];
+					std::to_chars_result result;
+					if (type == GlslType::Float)
+					{
+						const float x = *reinterpret_cast<const float*>(value);
+						if (!std::isfinite(x))
+						{
+							return {};
+						}
+						result = std::to_chars(buffer, buffer + sizeof(buffer), x);
+					}
+					else
+					{
+						const double x = *reinterpret_cast<const double*>(value);
+						if (!std::isfinite(x))
+						{
+							return {};
+						}
+						result = std::to_chars(buffer, buffer + sizeof(buffer), x);
+					}
+
+					std::string literal(buffer, result.ptr);
+					if (literal.find_first_of(".e") == std::string::npos)
+					{
+						literal += ".0";
+					}
+					if (type == GlslType::Double)
+					{
+						literal += "lf";
+					}
+
+					return literal;
+				}
+				default:
+					assert(false);
+					return {};
+			}
+		}
+	}
+
+	ShaderSpecializer::ShaderSpecializer() :
+		_program(nullptr),
+		_stages(),
+		_sources(),
+		_candidates(),
+		_stableFrameCount(120),
+		_genericProgram(),
+		_pendingModules(),
+		_pendingProgram(),
+		_pendingDefines(),
+		_failedDefines(),
+		_variantCount(0)
+	{
+	}
+
+	ShaderSpecializer::ShaderSpecializer(ShaderProgram* program, const ShaderStage::Stage* stages, const std::filesystem::path* glslFiles, uint8_t count, const ShaderPreprocessor* preprocessor, const std::map<std::string, std::string>& defines) : ShaderSpecializer()
+	{
+		createFromGlsl(program, stages, glslFiles, count, preprocessor, defines);
+	}
+
+	bool ShaderSpecializer::createFromGlsl(ShaderProgram* program, const ShaderStage::Stage* stages, const std::filesystem::path* glslFiles, uint8_t count, const ShaderPreprocessor* preprocessor, const std::map<std::string, std::string>& defines)
+	{
+		assert(program != nullptr && program->isValid());
+		assert(count != 0 && count <= 5);
+
+		destroy();
+
+		// The program is expected to be built from the same files and defines: it is the generic variant
+
+		const ShaderPreprocessor defaultPreprocessor;
+		if (!preprocessor)
+		{
+			preprocessor = &defaultPreprocessor;
+		}
+
+		for (uint8_t i = 0; i < count; ++i)
+		{
+			std::string& source = _sources.emplace_back();
+			if (!preprocessor->preprocess(glslFiles[i], defines, source))
+			{
+				destroy();
+				return false;
+			}
+
+			_stages.push_back(stages[i]);
+		}
+
+		_program = program;
+
+		return true;
+	}
+
+	void ShaderSpecializer::addCandidate(const std::string& name)
+	{
+		assert(isValid());
+		assert(name.find_first_of(".[") == std::string::npos);	// Only plain scalar uniforms can be turned into defines
+
+		const uint64_t nameHash = Name(name).hash;
+		for (const Candidate& candidate : _candidates)
+		{
+			if (candidate.nameHash == nameHash)
+			{
+				return;
+			}
+		}
+
+		Candidate& candidate = _candidates.emplace_back();
+		candidate.name = name;
+		candidate.nameHash = nameHash;
+	}
+
+	void ShaderSpecializer::setStableFrameCount(uint32_t frameCount)
+	{
+		_stableFrameCount = frameCount;
+	}
+
+	void ShaderSpecializer::destroy()
+	{
+		// The watched program is left generic, with the current values of the candidates
+
+		if (_genericProgram)
+		{
+			_restoreGenericProgram();
+		}
+
+		_program = nullptr;
+		_stages.clear();
+		_sources.clear();
+
+		_candidates.clear();
+
+		_genericProgram.reset();
+		_pendingProgram.reset();
+		_pendingModules.reset();
+		_pendingDefines.clear();
+		_failedDefines.clear();
+		_variantCount = 0;
+	}
+
+	bool ShaderSpecializer::update()
+	{
+		assert(isValid());
+
+		bool swapped = false;
+
+		// A variant is only swapped in if the values it was built for are still the current ones
+
+		if (_pendingProgram && _pendingProgram->isLinkingComplete())
+		{
+			for (uint8_t i = 0; i < _stages.size(); ++i)
+			{
+				_pendingModules[i].waitCompilation();
+			}
+
+			if (_pendingProgram->waitLinking())
+			{
+				bool upToDate = true;
+				for (const Candidate& candidate : _candidates)
+				{
+					upToDate = upToDate && (candidate.pendingLiteral.empty() || candidate.pendingLiteral == candidate.literal);
+				}
+
+				if (upToDate)
+				{
+					_swapProgram(*_pendingProgram);
+
+					// The program swapped out is the generic one, or a previous variant that is not needed anymore
+
+					if (!_genericProgram)
+					{
+						_genericProgram = std::move(_pendingProgram);
+					}
+
+					for (Candidate& candidate : _candidates)
+					{
+						candidate.specializedLiteral = candidate.pendingLiteral;
+					}
+					for (const Candidate& candidate : _candidates)
+					{
+						_applyCandidate(candidate);
+					}
+
+					++_variantCount;
+					swapped = true;
+				}
+			}
+			else
+			{
+				_failedDefines = _pendingDefines;
+			}
+
+			_pendingProgram.reset();
+			_pendingModules.reset();
+			_pendingDefines.clear();
+		}
+
+		// Build the variant for all the candidates currently stable, if it is not the one in use
+
+		std::string defines;
+		bool alreadySpecialized = true;
+		for (Candidate& candidate : _candidates)
+		{
+			if (candidate.literal.empty())
+			{
+				continue;
+			}
+
+			if (candidate.stableFrames < _stableFrameCount)
+			{
+				++candidate.stableFrames;
+			}
+
+			if (candidate.stableFrames >= _stableFrameCount)
+			{
+				defines += "#define SPL_SPECIALIZED_" + candidate.name + " " + candidate.literal + "\n";
+				alreadySpecialized = alreadySpecialized && candidate.specializedLiteral == candidate.literal;
+			}
+		}
+
+		if (!defines.empty() && !alreadySpecialized && !_pendingProgram && defines != _failedDefines)
+		{
+			_submitVariant(defines);
+		}
+
+		return swapped;
+	}
+
+	const ShaderProgram* ShaderSpecializer::getProgram() const
+	{
+		return _program;
+	}
+
+	bool ShaderSpecializer::isSpecialized() const
+	{
+		return _genericProgram != nullptr;
+	}
+
+	uint32_t ShaderSpecializer::getVariantCount() const
+	{
+		return _variantCount;
+	}
+
+	bool ShaderSpecializer::isValid() const
+	{
+		return _program != nullptr;
+	}
+
+	ShaderSpecializer::~ShaderSpecializer()
+	{
+		destroy();
+	}
+
+	bool ShaderSpecializer::_setCandidate(uint64_t nameHash, GlslType type, const void* value)
+	{
+		Candidate* candidate = nullptr;
+		for (Candidate& it : _candidates)
+		{
+			if (it.nameHash == nameHash)
+			{
+				candidate = &it;
+				break;
+			}
+		}
+
+		if (!candidate)
+		{
+			return false;
+		}
+
+		assert(candidate->type == GlslType::Undefined || candidate->type == type);
+
+		candidate->type = type;
+		if (type == GlslType::Bool)
+		{
+			const int32_t buffer = *reinterpret_cast<const bool*>(value);
+			std::copy_n(reinterpret_cast<const uint8_t*>(&buffer), sizeof(int32_t), reinterpret_cast<uint8_t*>(&candidate->value));
+		}
+		else
+		{
+			std::copy_n(reinterpret_cast<const uint8_t*>(value), _spl::glslTypeToSize(type), reinterpret_cast<uint8_t*>(&candidate->value));
+		}
+
+		std::string literal = scalarToLiteral(type, value);
+		if (literal != candidate->literal)
+		{
+			candidate->literal = std::move(literal);
+			candidate->stableFrames = 0;
+
+			// The value folded in the current variant is wrong from now on
+
+			if (!candidate->specializedLiteral.empty())
+			{
+				_restoreGenericProgram();
+				return true;
+			}
+		}
+
+		_applyCandidate(*candidate);
+
+		return true;
+	}
+
+	void ShaderSpecializer::_applyCandidate(const Candidate& candidate) const
+	{
+		if (candidate.type == GlslType::Undefined || !candidate.specializedLiteral.empty())
+		{
+			return;
+		}
+
+		const UniformHandle handle = _program->getUniformHandle(Name(candidate.name));
+		if (handle.location != -1)
+		{
+			_program->_setUniform(handle, (candidate.type == GlslType::Bool) ? GlslType::Int : candidate.type, &candidate.value, 1);
+		}
+	}
+
+	void ShaderSpecializer::_submitVariant(const std::string& defines)
+	{
+		const uint8_t count = _stages.size();
+
+		_pendingModules = std::make_unique<ShaderModule[]>(count);
+
+		const ShaderModule* moduleArray[5];
+		for (uint8_t i = 0; i < count; ++i)
+		{
+			const std::string source = ShaderModule::_injectDefines(_sources[i].data(), _sources[i].size(), defines);
+			_pendingModules[i].createFromGlslAsync(_stages[i], source.data(), source.size());
+
+			moduleArray[i] = &_pendingModules[i];
+		}
+
+		_pendingProgram = std::make_unique<ShaderProgram>();
+		_pendingProgram->createFromShaderModulesAsync(moduleArray, count, _program->getFlags());
+		_pendingDefines = defines;
+
+		for (Candidate& candidate : _candidates)
+		{
+			const bool specialized = !candidate.literal.empty() && candidate.stableFrames >= _stableFrameCount;
+			candidate.pendingLiteral = specialized ? candidate.literal : std::string();
+		}
+	}
+
+	void ShaderSpecializer::_swapProgram(ShaderProgram& program)
+	{
+		// The uniforms and subroutines set on the current program are set on the new one before it replaces it
+
+		program._copyUniformValues(*_program);
+		program._copySubroutineSelections(*_program);
+		_program->_swap(program);
+	}
+
+	void ShaderSpecializer::_restoreGenericProgram()
+	{
+		assert(_genericProgram);
+
+		_swapProgram(*_genericProgram);
+		_genericProgram.reset();
+
+		for (Candidate& candidate : _candidates)
+		{
+			candidate.specializedLiteral.clear();
+		}
+		for (const Candidate& candidate : _candidates)
+		{
+			_applyCandidate(candidate);
+		}
+	}
+}
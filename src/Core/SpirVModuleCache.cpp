@@ -0,0 +1,171 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2021-2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <SplayLibrary/Core/Core.hpp>
+#include <SplayLibrary/Private/PrivateNotIncluded.hpp>
+
+#if defined(__unix__) || defined(__APPLE__)
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace spl
+{
+	SpirVModuleCache::SpirVModuleCache() :
+		_files(),
+		_modules()
+	{
+	}
+
+	const ShaderModule* SpirVModuleCache::getModule(ShaderStage::Stage stage, const std::filesystem::path& spirvFile, const char* entryPoint, const uint32_t* constantIndices, const void* constantValues, uint32_t specializationConstantsCount)
+	{
+		assert(entryPoint != nullptr);
+		assert(specializationConstantsCount == 0 || (constantIndices != nullptr && constantValues != nullptr));
+
+		const MappedFile* file = _mapFile(spirvFile);
+		if (!file)
+		{
+			return nullptr;
+		}
+
+		// Compute the key of the variant
+
+		uint64_t key = _spl::fnv1a(reinterpret_cast<const char*>(&file->hash), sizeof(uint64_t));
+		key = _spl::fnv1a(reinterpret_cast<const char*>(&stage), sizeof(ShaderStage::Stage), key);
+		key = _spl::fnv1a(entryPoint, std::char_traits<char>::length(entryPoint) + 1, key);
+		key = _spl::fnv1a(reinterpret_cast<const char*>(constantIndices), specializationConstantsCount * sizeof(uint32_t), key);
+		key = _spl::fnv1a(reinterpret_cast<const char*>(constantValues), specializationConstantsCount * sizeof(uint32_t), key);
+
+		const uint32_t* values = reinterpret_cast<const uint32_t*>(constantValues);
+
+		// Different variants may share the same hash, the whole key is compared
+
+		const auto range = _modules.equal_range(key);
+		for (std::unordered_multimap<uint64_t, Entry>::const_iterator it = range.first; it != range.second; ++it)
+		{
+			const Entry& entry = it->second;
+			if (entry.fileHash == file->hash && entry.stage == stage && entry.entryPoint == entryPoint
+				&& std::equal(entry.constantIndices.begin(), entry.constantIndices.end(), constantIndices, constantIndices + specializationConstantsCount)
+				&& std::equal(entry.constantValues.begin(), entry.constantValues.end(), values, values + specializationConstantsCount))
+			{
+				return entry.module->isValid() ? entry.module.get() : nullptr;
+			}
+		}
+
+		// Specialize the module if it was never requested. Failures are kept too, so that they are not specialized again.
+
+		Entry entry;
+		entry.fileHash = file->hash;
+		entry.stage = stage;
+		entry.entryPoint = entryPoint;
+		entry.constantIndices.assign(constantIndices, constantIndices + specializationConstantsCount);
+		entry.constantValues.assign(values, values + specializationConstantsCount);
+		entry.module = std::make_unique<ShaderModule>(stage, file->data, file->size, entryPoint, constantIndices, constantValues, specializationConstantsCount);
+
+		const ShaderModule* module = _modules.emplace(key, std::move(entry))->second.module.get();
+
+		return module->isValid() ? module : nullptr;
+	}
+
+	void SpirVModuleCache::clear()
+	{
+		_modules.clear();
+
+		for (std::pair<const std::string, MappedFile>& file : _files)
+		{
+			_unmapFile(file.second);
+		}
+		_files.clear();
+	}
+
+	uint32_t SpirVModuleCache::getFileCount() const
+	{
+		return _files.size();
+	}
+
+	uint32_t SpirVModuleCache::getModuleCount() const
+	{
+		return _modules.size();
+	}
+
+	SpirVModuleCache::~SpirVModuleCache()
+	{
+		clear();
+	}
+
+	const SpirVModuleCache::MappedFile* SpirVModuleCache::_mapFile(const std::filesystem::path& spirvFile)
+	{
+		std::error_code error;
+		const std::string path = std::filesystem::absolute(spirvFile, error).lexically_normal().string();
+
+		const auto it = _files.find(path);
+		if (it != _files.end())
+		{
+			return &it->second;
+		}
+
+		MappedFile file;
+
+#if defined(__unix__) || defined(__APPLE__)
+		const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (fd == -1)
+		{
+			return nullptr;
+		}
+
+		struct stat fileStat;
+		if (fstat(fd, &fileStat) == 0 && fileStat.st_size != 0)
+		{
+			void* data = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (data != MAP_FAILED)
+			{
+				file.data = data;
+				file.size = fileStat.st_size;
+			}
+		}
+
+		close(fd);
+#else
+		std::ifstream stream(path, std::ios::ate | std::ios::binary);
+		if (stream)
+		{
+			file.content.resize(stream.tellg());
+			stream.seekg(0);
+			stream.read(reinterpret_cast<char*>(file.content.data()), file.content.size());
+
+			if (stream && !file.content.empty())
+			{
+				file.data = file.content.data();
+				file.size = file.content.size();
+			}
+		}
+#endif
+
+		if (!file.data)
+		{
+			return nullptr;
+		}
+
+		file.hash = _spl::fnv1a(reinterpret_cast<const char*>(file.data), file.size);
+
+		return &_files.emplace(path, std::move(file)).first->second;
+	}
+
+	void SpirVModuleCache::_unmapFile(MappedFile& file)
+	{
+#if defined(__unix__) || defined(__APPLE__)
+		if (file.data)
+		{
+			munmap(const_cast<void*>(file.data), file.size);
+		}
+#endif
+
+		file = MappedFile();
+	}
+}
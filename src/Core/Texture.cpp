@@ -10,6 +10,60 @@
 
 namespace spl
 {
+	namespace
+	{
+		uint64_t computeTextureMemorySize(const TextureCreationParams& params)
+		{
+			// Buffer textures do not own their storage, it is accounted by the buffer
+
+			if (params.target == TextureTarget::Buffer)
+			{
+				return 0;
+			}
+
+			const bool isMultisample = (params.target == TextureTarget::Multisample2D || params.target == TextureTarget::Multisample2DArray);
+			const uint32_t levels = (isMultisample || params.target == TextureTarget::Rectangle) ? 1 : params.levels;
+			const uint64_t samples = isMultisample ? params.samples : 1;
+
+			uint64_t texelCount = 0;
+			for (uint32_t i = 0; i < levels; ++i)
+			{
+				const uint64_t width = std::max(params.width >> i, 1u);
+				const uint64_t height = std::max(params.height >> i, 1u);
+				const uint64_t depth = std::max(params.depth >> i, 1u);
+
+				switch (params.target)
+				{
+					case TextureTarget::Texture1D:
+						texelCount += width;
+						break;
+					case TextureTarget::Array1D:
+						texelCount += width * params.height;
+						break;
+					case TextureTarget::Texture2D:
+					case TextureTarget::Rectangle:
+					case TextureTarget::Multisample2D:
+						texelCount += width * height;
+						break;
+					case TextureTarget::Texture3D:
+						texelCount += width * height * depth;
+						break;
+					case TextureTarget::Array2D:
+					case TextureTarget::CubeMap:
+					case TextureTarget::CubeMapArray:
+					case TextureTarget::Multisample2DArray:
+						texelCount += width * height * params.depth;
+						break;
+					default:
+						assert(false);
+						break;
+				}
+			}
+
+			return (texelCount * samples * _spl::textureInternalFormatToTexelBits(params.internalFormat) + 7) / 8;
+		}
+	}
+
 	Texture::Texture() :
 		_texture(0),
 		_params(),
@@ -25,7 +79,13 @@ namespace spl
 		_maxAnisotropy(),
 		_sWrap(),
 		_tWrap(),
-		_rWrap()
+		_rWrap(),
+
+		_label(),
+		_contextBindings(),
+		_contextImageBindings(),
+		_shaderWriteEpoch(0),
+		_hasBindlessHandle(false)
 	{
 	}
 
@@ -45,6 +105,11 @@ namespace spl
 		_params.internalFormat = params.internalFormat;
 		glCreateTextures(_spl::textureTargetToGLenum(_params.target), 1, &_texture);
 
+		if (!_label.empty())
+		{
+			glObjectLabel(GL_TEXTURE, _texture, _label.size(), _label.data());
+		}
+
 		switch (_params.target)
 		{
 			case TextureTarget::Texture1D:
@@ -220,6 +285,8 @@ namespace spl
 			}
 		}
 
+		Context::_addTextureMemory(_label, getMemorySize());
+
 		_newTextureParameters();
 	}
 
@@ -232,6 +299,8 @@ namespace spl
 			|| params.data == nullptr && params.bufferData == nullptr && params.framebufferData != nullptr
 		);
 
+		Context::getCurrentContext()->_prepareTextureUpdate(this, params.bufferData);
+
 		if (params.framebufferData)
 		{
 			const Framebuffer* contextFramebuffer = Context::getCurrentContext()->getFramebufferBinding(FramebufferTarget::ReadFramebuffer);
@@ -369,24 +438,41 @@ namespace spl
 		}
 	}
 
+	void Texture::setLabel(const std::string& label)
+	{
+		if (_texture != 0)
+		{
+			Context::_moveMemoryLabel(_label, label, getMemorySize());
+			glObjectLabel(GL_TEXTURE, _texture, label.size(), label.data());
+		}
+
+		_label = label;
+	}
+
 	void Texture::destroy()
 	{
 		if (_texture != 0)
 		{
 			_detachFramebuffers();
 
-			Context::getCurrentContext()->_unbindTexture(this);
+			Context* context = Context::getCurrentContext();
+			context->_unbindTexture(this);
+			Context::_addTextureMemory(_label, -static_cast<int64_t>(getMemorySize()));
+
+			TextureResidency::_forget(this);
 
 			glDeleteTextures(1, &_texture);
 
 			_texture = 0;
 			_params = {};
+			_hasBindlessHandle = false;
 		}
 	}
 
 	void Texture::setBorderColor(float r, float g, float b, float a)
 	{
 		assert(isValid());
+		assert(!_hasBindlessHandle);
 
 		_borderColor.x = r;
 		_borderColor.y = g;
@@ -398,6 +484,7 @@ namespace spl
 	void Texture::setCompareMode(TextureCompareMode compareMode)
 	{
 		assert(isValid());
+		assert(!_hasBindlessHandle);
 
 		_compareMode = compareMode;
 		glTextureParameteri(_texture, GL_TEXTURE_COMPARE_MODE, _spl::textureCompareModeToGLenum(_compareMode));
@@ -406,6 +493,7 @@ namespace spl
 	void Texture::setCompareFunc(CompareFunc compareFunc)
 	{
 		assert(isValid());
+		assert(!_hasBindlessHandle);
 
 		_compareFunc = compareFunc;
 		glTextureParameteri(_texture, GL_TEXTURE_COMPARE_FUNC, _spl::compareFuncToGLenum(_compareFunc));
@@ -414,6 +502,7 @@ namespace spl
 	void Texture::setMinLod(float lod)
 	{
 		assert(isValid());
+		assert(!_hasBindlessHandle);
 
 		_minLod = lod;
 		glTextureParameterf(_texture, GL_TEXTURE_MIN_LOD, _minLod);
@@ -422,6 +511,7 @@ namespace spl
 	void Texture::setMaxLod(float lod)
 	{
 		assert(isValid());
+		assert(!_hasBindlessHandle);
 
 		_maxLod = lod;
 		glTextureParameterf(_texture, GL_TEXTURE_MAX_LOD, _maxLod);
@@ -430,6 +520,7 @@ namespace spl
 	void Texture::setLodBias(float bias)
 	{
 		assert(isValid());
+		assert(!_hasBindlessHandle);
 
 		_lodBias = bias;
 		glTextureParameterf(_texture, GL_TEXTURE_LOD_BIAS, _lodBias);
@@ -438,6 +529,7 @@ namespace spl
 	void Texture::setMinFiltering(TextureFiltering filtering)
 	{
 		assert(isValid());
+		assert(!_hasBindlessHandle);
 
 		_minFilter = filtering;
 		glTextureParameteri(_texture, GL_TEXTURE_MIN_FILTER, _spl::textureFilteringToGLenum(_minFilter));
@@ -446,6 +538,7 @@ namespace spl
 	void Texture::setMagFiltering(TextureFiltering filtering)
 	{
 		assert(isValid());
+		assert(!_hasBindlessHandle);
 
 		_magFilter = filtering;
 		glTextureParameteri(_texture, GL_TEXTURE_MAG_FILTER, _spl::textureFilteringToGLenum(_magFilter));
@@ -454,6 +547,7 @@ namespace spl
 	void Texture::setMaxAnisotropy(float maxAnisotropy)
 	{
 		assert(isValid());
+		assert(!_hasBindlessHandle);
 		assert(maxAnisotropy >= 1.f);
 
 		_maxAnisotropy = maxAnisotropy;
@@ -463,6 +557,7 @@ namespace spl
 	void Texture::setWrappingS(TextureWrapping wrap)
 	{
 		assert(isValid());
+		assert(!_hasBindlessHandle);
 
 		_sWrap = wrap;
 		glTextureParameteri(_texture, GL_TEXTURE_WRAP_S, _spl::textureWrappingToGLenum(_sWrap));
@@ -471,6 +566,7 @@ namespace spl
 	void Texture::setWrappingT(TextureWrapping wrap)
 	{
 		assert(isValid());
+		assert(!_hasBindlessHandle);
 
 		_tWrap = wrap;
 		glTextureParameteri(_texture, GL_TEXTURE_WRAP_T, _spl::textureWrappingToGLenum(_tWrap));
@@ -479,6 +575,7 @@ namespace spl
 	void Texture::setWrappingR(TextureWrapping wrap)
 	{
 		assert(isValid());
+		assert(!_hasBindlessHandle);
 
 		_rWrap = wrap;
 		glTextureParameteri(_texture, GL_TEXTURE_WRAP_R, _spl::textureWrappingToGLenum(_rWrap));
@@ -494,11 +591,47 @@ namespace spl
 		return _texture;
 	}
 
+	uint64_t Texture::getBindlessHandle(const Sampler* sampler) const
+	{
+		assert(isValid());
+		assert(TextureResidency::isSupported());
+		assert(sampler == nullptr || sampler->isValid());
+
+		// Creating a handle makes the sampling state of the texture, and of the sampler, immutable
+
+		_hasBindlessHandle = true;
+
+		if (sampler)
+		{
+			sampler->_hasBindlessHandle = true;
+			return glGetTextureSamplerHandleARB(_texture, sampler->getHandle());
+		}
+		else
+		{
+			return glGetTextureHandleARB(_texture);
+		}
+	}
+
 	const TextureCreationParams& Texture::getCreationParams() const
 	{
 		return _params;
 	}
 
+	const std::string& Texture::getLabel() const
+	{
+		return _label;
+	}
+
+	uint64_t Texture::getMemorySize() const
+	{
+		if (_texture == 0)
+		{
+			return 0;
+		}
+
+		return computeTextureMemorySize(_params);
+	}
+
 	const scp::f32vec4& Texture::getBorderColor() const
 	{
 		return _borderColor;
@@ -566,12 +699,12 @@ namespace spl
 
 	void Texture::bind(const Texture* texture, uint32_t textureUnit)
 	{
-		std::vector<const Texture*>& contextTextures = Context::getCurrentContext()->_state.textureBindings;
+		Context* context = Context::getCurrentContext();
 
 		assert(texture == nullptr || texture->isValid());
-		assert(textureUnit < contextTextures.size());
+		assert(textureUnit < context->_state.textureBindings.size());
 
-		contextTextures[textureUnit] = texture;
+		context->_setTextureBinding(textureUnit, texture);
 
 		if (texture)
 		{
@@ -585,19 +718,25 @@ namespace spl
 
 	void Texture::bind(const Texture* const* textures, uint32_t firstUnit, uint32_t count)
 	{
-		std::vector<const Texture*>& contextTextures = Context::getCurrentContext()->_state.textureBindings;
+		Context* context = Context::getCurrentContext();
 
-		assert(firstUnit + count <= contextTextures.size());
+		assert(firstUnit + count <= context->_state.textureBindings.size());
 
 		if (textures == nullptr)
 		{
-			std::fill_n(contextTextures.begin() + firstUnit, count, nullptr);
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				context->_setTextureBinding(firstUnit + i, nullptr);
+			}
 
 			glBindTextures(firstUnit, count, nullptr);
 		}
 		else
 		{
-			std::copy_n(textures, count, contextTextures.begin() + firstUnit);
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				context->_setTextureBinding(firstUnit + i, textures[i]);
+			}
 
 			uint32_t* names = reinterpret_cast<uint32_t*>(alloca(sizeof(uint32_t) * count));
 			for (uint32_t i = 0; i < count; ++i)
@@ -617,6 +756,96 @@ namespace spl
 		}
 	}
 
+	void Texture::bindImage(const Texture* texture, uint32_t imageUnit, ImageAccess access, TextureInternalFormat format, uint32_t level, int32_t layer)
+	{
+		Context* context = Context::getCurrentContext();
+
+		assert(imageUnit < context->_state.imageBindings.size());
+
+		if (texture == nullptr)
+		{
+			context->_setImageBinding(imageUnit, {});
+			glBindImageTexture(imageUnit, 0, 0, false, 0, GL_READ_ONLY, GL_R8);
+			return;
+		}
+
+		const TextureCreationParams& params = texture->_params;
+		format = (format == TextureInternalFormat::Undefined) ? params.internalFormat : format;
+
+		assert(texture->isValid());
+		assert(level < params.levels);
+		assert(_spl::isImageUnitFormat(format));
+		assert(_spl::textureInternalFormatToTexelBits(format) == _spl::textureInternalFormatToTexelBits(params.internalFormat));
+		assert(layer == -1
+			|| params.target == TextureTarget::Texture3D
+			|| params.target == TextureTarget::Array1D
+			|| params.target == TextureTarget::Array2D
+			|| params.target == TextureTarget::CubeMap
+			|| params.target == TextureTarget::CubeMapArray
+			|| params.target == TextureTarget::Multisample2DArray);
+
+		ImageUnitBinding binding;
+		binding.texture = texture;
+		binding.level = level;
+		binding.isLayered = (layer == -1);
+		binding.layer = (layer == -1) ? 0 : layer;
+		binding.access = access;
+		binding.format = format;
+
+		context->_setImageBinding(imageUnit, binding);
+
+		glBindImageTexture(imageUnit, texture->_texture, binding.level, binding.isLayered, binding.layer, _spl::imageAccessToGLenum(access), _spl::textureInternalFormatToGLenum(format));
+	}
+
+	void Texture::bindImages(const Texture* const* textures, uint32_t firstUnit, uint32_t count)
+	{
+		Context* context = Context::getCurrentContext();
+
+		assert(firstUnit + count <= context->_state.imageBindings.size());
+
+		// glBindImageTextures binds the whole first level of each texture, layered, in read-write access and with the
+		// internal format of the texture
+
+		if (textures == nullptr)
+		{
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				context->_setImageBinding(firstUnit + i, {});
+			}
+
+			glBindImageTextures(firstUnit, count, nullptr);
+		}
+		else
+		{
+			uint32_t* names = reinterpret_cast<uint32_t*>(alloca(sizeof(uint32_t) * count));
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				ImageUnitBinding binding;
+
+				if (textures[i] == nullptr)
+				{
+					names[i] = 0;
+				}
+				else
+				{
+					assert(textures[i]->isValid());
+					assert(_spl::isImageUnitFormat(textures[i]->_params.internalFormat));
+
+					names[i] = textures[i]->_texture;
+
+					binding.texture = textures[i];
+					binding.isLayered = true;
+					binding.access = ImageAccess::ReadWrite;
+					binding.format = textures[i]->_params.internalFormat;
+				}
+
+				context->_setImageBinding(firstUnit + i, binding);
+			}
+
+			glBindImageTextures(firstUnit, count, names);
+		}
+	}
+
 	void Texture::_newTextureParameters()
 	{
 		_borderColor = { 0.f, 0.f, 0.f, 0.f };
@@ -0,0 +1,95 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//! \file
+//! \author Reiex
+//! \copyright The MIT License (MIT)
+//! \date 2021-2023
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <SplayLibrary/Core/Core.hpp>
+#include <SplayLibrary/Private/PrivateNotIncluded.hpp>
+
+namespace spl
+{
+	std::mutex TextureResidency::_mutex;
+	std::map<std::pair<const Context*, uint64_t>, TextureResidency::Entry> TextureResidency::_entries;
+
+	uint64_t TextureResidency::acquire(const Texture& texture, const Sampler* sampler)
+	{
+		assert(texture.isValid());
+		assert(sampler == nullptr || sampler->isValid());
+
+		if (!isSupported())
+		{
+			return 0;
+		}
+
+		const Context* context = Context::getCurrentContext();
+		const uint64_t handle = texture.getBindlessHandle(sampler);
+
+		std::lock_guard lock(_mutex);
+
+		Entry& entry = _entries[{ context, handle }];
+		if (entry.refCount == 0)
+		{
+			glMakeTextureHandleResidentARB(handle);
+			entry = { &texture, 0 };
+		}
+
+		++entry.refCount;
+
+		return handle;
+	}
+
+	void TextureResidency::release(uint64_t handle)
+	{
+		if (handle == 0)
+		{
+			return;
+		}
+
+		std::lock_guard lock(_mutex);
+
+		const auto it = _entries.find({ Context::getCurrentContext(), handle });
+		if (it == _entries.end())
+		{
+			return;
+		}
+
+		if (--it->second.refCount == 0)
+		{
+			glMakeTextureHandleNonResidentARB(handle);
+			_entries.erase(it);
+		}
+	}
+
+	bool TextureResidency::isSupported()
+	{
+		return GLAD_GL_ARB_bindless_texture;
+	}
+
+	bool TextureResidency::isResident(uint64_t handle)
+	{
+		std::lock_guard lock(_mutex);
+
+		return _entries.contains({ Context::getCurrentContext(), handle });
+	}
+
+	uint32_t TextureResidency::getResidentCount()
+	{
+		std::lock_guard lock(_mutex);
+
+		return _entries.size();
+	}
+
+	void TextureResidency::_forget(const Texture* texture)
+	{
+		// The handles of a texture are deleted with it, they do not need to be made non-resident
+
+		std::lock_guard lock(_mutex);
+
+		if (!_entries.empty())
+		{
+			std::erase_if(_entries, [&](const std::pair<const std::pair<const Context*, uint64_t>, Entry>& entry) { return entry.second.texture == texture; });
+		}
+	}
+}
@@ -11,7 +11,9 @@
 namespace spl
 {
 	VertexArray::VertexArray() :
-		_vao(0)
+		_vao(0),
+		_elementBuffer(nullptr),
+		_arrayBuffers()
 	{
 		glCreateVertexArrays(1, &_vao);
 	}
@@ -20,6 +22,8 @@ namespace spl
 	{
 		assert(buffer == nullptr || buffer->isValid());
 
+		_elementBuffer = buffer;
+
 		if (buffer)
 		{
 			glVertexArrayElementBuffer(_vao, buffer->getHandle());
@@ -34,6 +38,12 @@ namespace spl
 	{
 		assert(buffer == nullptr || buffer->isValid());
 
+		if (bindingIndex >= _arrayBuffers.size())
+		{
+			_arrayBuffers.resize(bindingIndex + 1, nullptr);
+		}
+		_arrayBuffers[bindingIndex] = buffer;
+
 		if (buffer)
 		{
 			glVertexArrayVertexBuffer(_vao, bindingIndex, buffer->getHandle(), offset, stride);
@@ -46,6 +56,16 @@ namespace spl
 
 	void VertexArray::bindArrayBuffer(const Buffer* const* buffers, uint32_t firstIndex, uint32_t count, const uint32_t* strides, const uintptr_t* offsets)
 	{
+		if (firstIndex + count > _arrayBuffers.size())
+		{
+			_arrayBuffers.resize(firstIndex + count, nullptr);
+		}
+
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			_arrayBuffers[firstIndex + i] = buffers ? buffers[i] : nullptr;
+		}
+
 		if (!buffers)
 		{
 			assert(strides == nullptr);
@@ -266,27 +286,45 @@ namespace spl
 
 	void VertexArray::drawArrays(PrimitiveType type, uint32_t first, uint32_t count, uint32_t instanceCount, uint32_t baseInstance) const
 	{
+		Context* context = Context::getCurrentContext();
+		context->_prepareShaderInvocation(this, false, nullptr);
+
 		glBindVertexArray(_vao);
 		glDrawArraysInstancedBaseInstance(_spl::primitiveTypeToGLenum(type), first, count, instanceCount, baseInstance);
 		glBindVertexArray(0);
+
+		context->_recordShaderWrites();
 	}
 
 	void VertexArray::drawElements(PrimitiveType primitiveType, IndexType indexType, uintptr_t first, uint32_t count, uint32_t instanceCount, uint32_t baseInstance, uint32_t baseVertex) const
 	{
+		Context* context = Context::getCurrentContext();
+		context->_prepareShaderInvocation(this, true, nullptr);
+
 		glBindVertexArray(_vao);
 		glDrawElementsInstancedBaseVertexBaseInstance(_spl::primitiveTypeToGLenum(primitiveType), count, _spl::indexTypeToGLenum(indexType), reinterpret_cast<const void*>(first), instanceCount, baseVertex, baseInstance);
 		glBindVertexArray(0);
+
+		context->_recordShaderWrites();
 	}
 
 	void VertexArray::multiDrawArrays(PrimitiveType type, const uint32_t* firsts, const uint32_t* counts, uint32_t drawCount) const
 	{
+		Context* context = Context::getCurrentContext();
+		context->_prepareShaderInvocation(this, false, nullptr);
+
 		glBindVertexArray(_vao);
 		glMultiDrawArrays(_spl::primitiveTypeToGLenum(type), reinterpret_cast<const GLint*>(firsts), reinterpret_cast<const GLsizei*>(counts), drawCount);
 		glBindVertexArray(0);
+
+		context->_recordShaderWrites();
 	}
 
 	void VertexArray::multiDrawElements(PrimitiveType primitiveType, IndexType indexType, const uintptr_t* firsts, const uint32_t* counts, uint32_t drawCount, const uint32_t* baseVertex) const
 	{
+		Context* context = Context::getCurrentContext();
+		context->_prepareShaderInvocation(this, true, nullptr);
+
 		glBindVertexArray(_vao);
 
 		if (baseVertex)
@@ -299,6 +337,124 @@ namespace spl
 		}
 
 		glBindVertexArray(0);
+
+		context->_recordShaderWrites();
+	}
+
+	void VertexArray::drawArraysIndirect(PrimitiveType type, const Buffer& buffer, uintptr_t offset) const
+	{
+		assert(buffer.isValid());
+		assert(offset % 4 == 0);
+		assert(offset + sizeof(DrawArraysCommand) <= buffer.getSize());
+
+		_bindIndirectBuffer(buffer);
+
+		Context* context = Context::getCurrentContext();
+		context->_prepareShaderInvocation(this, false, &buffer);
+
+		glBindVertexArray(_vao);
+		glDrawArraysIndirect(_spl::primitiveTypeToGLenum(type), reinterpret_cast<const void*>(offset));
+		glBindVertexArray(0);
+
+		context->_recordShaderWrites();
+	}
+
+	void VertexArray::drawElementsIndirect(PrimitiveType primitiveType, IndexType indexType, const Buffer& buffer, uintptr_t offset) const
+	{
+		assert(buffer.isValid());
+		assert(offset % 4 == 0);
+		assert(offset + sizeof(DrawElementsCommand) <= buffer.getSize());
+
+		_bindIndirectBuffer(buffer);
+
+		Context* context = Context::getCurrentContext();
+		context->_prepareShaderInvocation(this, true, &buffer);
+
+		glBindVertexArray(_vao);
+		glDrawElementsIndirect(_spl::primitiveTypeToGLenum(primitiveType), _spl::indexTypeToGLenum(indexType), reinterpret_cast<const void*>(offset));
+		glBindVertexArray(0);
+
+		context->_recordShaderWrites();
+	}
+
+	void VertexArray::multiDrawArraysIndirect(PrimitiveType type, const Buffer& buffer, uint32_t drawCount, uintptr_t offset, uint32_t stride) const
+	{
+		assert(buffer.isValid());
+		assert(offset % 4 == 0 && stride % 4 == 0);
+		assert(stride >= sizeof(DrawArraysCommand));
+		assert(drawCount == 0 || offset + (drawCount - 1) * stride + sizeof(DrawArraysCommand) <= buffer.getSize());
+
+		_bindIndirectBuffer(buffer);
+
+		Context* context = Context::getCurrentContext();
+		context->_prepareShaderInvocation(this, false, &buffer);
+
+		glBindVertexArray(_vao);
+		glMultiDrawArraysIndirect(_spl::primitiveTypeToGLenum(type), reinterpret_cast<const void*>(offset), drawCount, stride);
+		glBindVertexArray(0);
+
+		context->_recordShaderWrites();
+	}
+
+	void VertexArray::multiDrawElementsIndirect(PrimitiveType primitiveType, IndexType indexType, const Buffer& buffer, uint32_t drawCount, uintptr_t offset, uint32_t stride) const
+	{
+		assert(buffer.isValid());
+		assert(offset % 4 == 0 && stride % 4 == 0);
+		assert(stride >= sizeof(DrawElementsCommand));
+		assert(drawCount == 0 || offset + (drawCount - 1) * stride + sizeof(DrawElementsCommand) <= buffer.getSize());
+
+		_bindIndirectBuffer(buffer);
+
+		Context* context = Context::getCurrentContext();
+		context->_prepareShaderInvocation(this, true, &buffer);
+
+		glBindVertexArray(_vao);
+		glMultiDrawElementsIndirect(_spl::primitiveTypeToGLenum(primitiveType), _spl::indexTypeToGLenum(indexType), reinterpret_cast<const void*>(offset), drawCount, stride);
+		glBindVertexArray(0);
+
+		context->_recordShaderWrites();
+	}
+
+	void VertexArray::multiDrawArraysIndirectCount(PrimitiveType type, const Buffer& buffer, const Buffer& countBuffer, uint32_t maxDrawCount, uintptr_t offset, uintptr_t countOffset, uint32_t stride) const
+	{
+		assert(buffer.isValid() && countBuffer.isValid());
+		assert(offset % 4 == 0 && countOffset % 4 == 0 && stride % 4 == 0);
+		assert(stride >= sizeof(DrawArraysCommand));
+		assert(maxDrawCount == 0 || offset + (maxDrawCount - 1) * stride + sizeof(DrawArraysCommand) <= buffer.getSize());
+		assert(countOffset + sizeof(uint32_t) <= countBuffer.getSize());
+
+		_bindIndirectBuffer(buffer);
+		_bindParameterBuffer(countBuffer);
+
+		Context* context = Context::getCurrentContext();
+		context->_prepareShaderInvocation(this, false, &buffer, &countBuffer);
+
+		glBindVertexArray(_vao);
+		glMultiDrawArraysIndirectCount(_spl::primitiveTypeToGLenum(type), reinterpret_cast<const void*>(offset), countOffset, maxDrawCount, stride);
+		glBindVertexArray(0);
+
+		context->_recordShaderWrites();
+	}
+
+	void VertexArray::multiDrawElementsIndirectCount(PrimitiveType primitiveType, IndexType indexType, const Buffer& buffer, const Buffer& countBuffer, uint32_t maxDrawCount, uintptr_t offset, uintptr_t countOffset, uint32_t stride) const
+	{
+		assert(buffer.isValid() && countBuffer.isValid());
+		assert(offset % 4 == 0 && countOffset % 4 == 0 && stride % 4 == 0);
+		assert(stride >= sizeof(DrawElementsCommand));
+		assert(maxDrawCount == 0 || offset + (maxDrawCount - 1) * stride + sizeof(DrawElementsCommand) <= buffer.getSize());
+		assert(countOffset + sizeof(uint32_t) <= countBuffer.getSize());
+
+		_bindIndirectBuffer(buffer);
+		_bindParameterBuffer(countBuffer);
+
+		Context* context = Context::getCurrentContext();
+		context->_prepareShaderInvocation(this, true, &buffer, &countBuffer);
+
+		glBindVertexArray(_vao);
+		glMultiDrawElementsIndirectCount(_spl::primitiveTypeToGLenum(primitiveType), _spl::indexTypeToGLenum(indexType), reinterpret_cast<const void*>(offset), countOffset, maxDrawCount, stride);
+		glBindVertexArray(0);
+
+		context->_recordShaderWrites();
 	}
 
 	uint32_t VertexArray::getHandle() const
@@ -310,4 +466,20 @@ namespace spl
 	{
 		glDeleteVertexArrays(1, &_vao);
 	}
+
+	void VertexArray::_bindIndirectBuffer(const Buffer& buffer) const
+	{
+		if (Context::getCurrentContext()->getBufferBinding(BufferTarget::DrawIndirect) != &buffer)
+		{
+			Buffer::bind(BufferTarget::DrawIndirect, &buffer);
+		}
+	}
+
+	void VertexArray::_bindParameterBuffer(const Buffer& buffer) const
+	{
+		if (Context::getCurrentContext()->getBufferBinding(BufferTarget::Parameter) != &buffer)
+		{
+			Buffer::bind(BufferTarget::Parameter, &buffer);
+		}
+	}
 }